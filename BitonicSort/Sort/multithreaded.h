@@ -0,0 +1,199 @@
+#ifndef BITONIC_SORT_MULTITHREADED_H
+#define BITONIC_SORT_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "../bitonic_simd.h"
+#include "sequential.h"
+
+
+/*
+Class for multithreaded bitonic sort on host.
+Array is divided into chunks, which are divided among threads. Threads are created only once and they are
+synchronized with spin barrier after every STEP, which crosses chunk boundaries. In these STEPS every thread
+compares a contiguous range of chunks, which contain comparators, with their partner chunks. All STEPS with
+stride lower than chunk size are fused - every thread performs them on its own chunks without synchronization
+(the same way as multistep bitonic sort performs multiple steps in registers). This way the number of barriers
+doesn't depend on array length, but only on the number of chunks.
+*/
+class BitonicSortMultithreaded : public BitonicSortSequential
+{
+protected:
+    std::string _sortName = "Bitonic sort multithreaded";
+    // Number of host threads used for sort
+    uint_t _numThreads = NUM_THREADS_BITONIC_SORT_MULTITHREADED > 0
+        ? NUM_THREADS_BITONIC_SORT_MULTITHREADED
+        : getNumHostThreads();
+
+    /*
+    Returns the size of chunks, which is power of 2 and at least tile size. Array is divided into at least
+    "MIN_CHUNKS_PER_THREAD_BITONIC_SORT_MULTITHREADED" chunks per thread, if it is long enough.
+    */
+    uint_t getChunkSize(uint_t arrayLength, uint_t tileSize, uint_t numThreads)
+    {
+        uint_t minNumChunks = numThreads * MIN_CHUNKS_PER_THREAD_BITONIC_SORT_MULTITHREADED;
+        uint_t chunkSize = tileSize;
+
+        while (arrayLength / chunkSize >= 2 * minNumChunks)
+        {
+            chunkSize <<= 1;
+        }
+
+        return chunkSize;
+    }
+
+    /*
+    Performs one STEP with stride greater or equal than chunk size. Chunks located in the first half of blocks
+    contain comparators. They are divided among threads in contiguous ranges.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicStepMultithreaded(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t stride, bool isFirstStepOfPhase,
+        uint_t chunkSize, uint_t threadIndex, uint_t numThreads
+    )
+    {
+        uint_t numChunks = (arrayLength - 1) / chunkSize + 1;
+        uint_t chunksPerHalfBlock = stride / chunkSize;
+        uint_t chunksRemainder = numChunks % (2 * chunksPerHalfBlock);
+        uint_t numChunksLower = (numChunks / (2 * chunksPerHalfBlock)) * chunksPerHalfBlock;
+        numChunksLower += chunksRemainder < chunksPerHalfBlock ? chunksRemainder : chunksPerHalfBlock;
+
+        uint_t lowerIdxStart = getThreadChunkStart(threadIndex, numThreads, numChunksLower);
+        uint_t lowerIdxEnd = getThreadChunkEnd(threadIndex, numThreads, numChunksLower);
+
+        for (uint_t lowerIdx = lowerIdxStart; lowerIdx < lowerIdxEnd; lowerIdx++)
+        {
+            uint_t chunkIdx = (lowerIdx / chunksPerHalfBlock) * 2 * chunksPerHalfBlock;
+            chunkIdx += lowerIdx % chunksPerHalfBlock;
+            uint_t chunkStart = chunkIdx * chunkSize;
+            uint_t chunkEnd = chunkStart + chunkSize < arrayLength ? chunkStart + chunkSize : arrayLength;
+
+            bitonicStepNetwork<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, arrayLength, chunkStart, chunkEnd, stride, isFirstStepOfPhase
+            );
+        }
+    }
+
+    /*
+    Sorts data with multithreaded NORMALIZED bitonic sort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicSortMultithreaded(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t tileSize, uint_t numThreads
+    )
+    {
+        if (arrayLength <= 1)
+        {
+            return;
+        }
+
+        uint_t chunkSize = getChunkSize(arrayLength, tileSize, numThreads);
+        uint_t numChunks = (arrayLength - 1) / chunkSize + 1;
+        numThreads = numThreads < numChunks ? numThreads : numChunks;
+        SpinBarrier barrier(numThreads);
+
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            uint_t chunkIdxStart = getThreadChunkStart(threadIndex, numThreads, numChunks);
+            uint_t chunkIdxEnd = getThreadChunkEnd(threadIndex, numThreads, numChunks);
+
+            // Sorts thread's chunks with cache-blocked bitonic sort
+            for (uint_t chunkIdx = chunkIdxStart; chunkIdx < chunkIdxEnd; chunkIdx++)
+            {
+                uint_t chunkStart = chunkIdx * chunkSize;
+                uint_t chunkEnd = chunkStart + chunkSize < arrayLength ? chunkStart + chunkSize : arrayLength;
+
+                bitonicSortSequential<sortOrder, sortingKeyOnly>(
+                    h_keys + chunkStart, sortingKeyOnly ? NULL : h_values + chunkStart, chunkEnd - chunkStart,
+                    tileSize, 1
+                );
+            }
+            barrier.wait();
+
+            for (uint_t subBlockSize = chunkSize; subBlockSize < arrayLength; subBlockSize <<= 1)
+            {
+                // STEPS, which cross chunk boundaries
+                for (uint_t stride = subBlockSize; stride >= chunkSize; stride >>= 1)
+                {
+                    bitonicStepMultithreaded<sortOrder, sortingKeyOnly>(
+                        h_keys, h_values, arrayLength, stride, stride == subBlockSize, chunkSize, threadIndex,
+                        numThreads
+                    );
+                    barrier.wait();
+                }
+
+                // Fused STEPS inside chunks
+                for (uint_t chunkIdx = chunkIdxStart; chunkIdx < chunkIdxEnd; chunkIdx++)
+                {
+                    uint_t chunkStart = chunkIdx * chunkSize;
+                    uint_t chunkEnd = chunkStart + chunkSize < arrayLength ? chunkStart + chunkSize : arrayLength;
+
+                    bitonicMergeSequential<sortOrder, sortingKeyOnly>(
+                        h_keys + chunkStart, sortingKeyOnly ? NULL : h_values + chunkStart, chunkEnd - chunkStart,
+                        subBlockSize, chunkSize / 2, tileSize, 1
+                    );
+                }
+                barrier.wait();
+            }
+        });
+    }
+
+    /*
+    Wrapper for multithreaded bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortMultithreaded<ORDER_ASC, true>(_h_keys, NULL, _arrayLength, _tileSizeKo, _numThreads);
+        }
+        else
+        {
+            bitonicSortMultithreaded<ORDER_DESC, true>(_h_keys, NULL, _arrayLength, _tileSizeKo, _numThreads);
+        }
+    }
+
+    /*
+    Wrapper for multithreaded bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortMultithreaded<ORDER_ASC, false>(
+                _h_keys, _h_values, _arrayLength, _tileSizeKv, _numThreads
+            );
+        }
+        else
+        {
+            bitonicSortMultithreaded<ORDER_DESC, false>(
+                _h_keys, _h_values, _arrayLength, _tileSizeKv, _numThreads
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Sets the number of host threads used for sort.
+    */
+    void setNumThreads(uint_t numThreads)
+    {
+        _numThreads = numThreads > 0 ? numThreads : 1;
+    }
+};
+
+#endif
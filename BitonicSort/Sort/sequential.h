@@ -8,6 +8,9 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "../bitonic_simd.h"
 
 
 /*
@@ -18,53 +21,98 @@ class BitonicSortSequential : public SortSequential
 protected:
     std::string _sortName = "Bitonic sort sequential";
 
+    // Size of tiles, in which steps with lower stride are performed while tile is resident in cache
+    uint_t _tileSizeKo = TILE_SIZE_BITONIC_SORT_SEQUENTIAL_KO;
+    uint_t _tileSizeKv = TILE_SIZE_BITONIC_SORT_SEQUENTIAL_KV;
+    // Number of host threads, which process independent tiles
+    uint_t _numThreadsTiles = NUM_THREADS_BITONIC_SORT_SEQUENTIAL > 0
+        ? NUM_THREADS_BITONIC_SORT_SEQUENTIAL
+        : getNumHostThreads();
+
     /*
-    Sorts data sequentially with NORMALIZED bitonic sort.
+    Executes "function(tileStart, tileEnd)" for every tile of array. Tiles are divided among threads in contiguous
+    chunks.
     */
-    template <order_t sortOrder, bool sortingKeyOnly>
-    void bitonicSortSequential(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    template <typename Function>
+    void forEachTile(uint_t arrayLength, uint_t tileSize, uint_t numThreads, Function function)
     {
-        for (uint_t subBlockSize = 1; subBlockSize < arrayLength; subBlockSize <<= 1)
+        uint_t numTiles = (arrayLength - 1) / tileSize + 1;
+        numThreads = numThreads < numTiles ? numThreads : numTiles;
+
+        runHostThreads(numThreads, [&](uint_t threadIndex)
         {
-            for (uint_t stride = subBlockSize; stride > 0; stride >>= 1)
+            uint_t tileIdxStart = getThreadChunkStart(threadIndex, numThreads, numTiles);
+            uint_t tileIdxEnd = getThreadChunkEnd(threadIndex, numThreads, numTiles);
+
+            for (uint_t tileIdx = tileIdxStart; tileIdx < tileIdxEnd; tileIdx++)
             {
-                bool isFirstStepOfPhase = stride == subBlockSize;
-
-                for (uint_t el = 0; el < arrayLength >> 1; el++)
-                {
-                    uint_t index = el;
-                    uint_t offset = stride;
-
-                    // In normalized bitonic sort, first STEP of every PHASE demands different offset than all other STEPS.
-                    if (isFirstStepOfPhase)
-                    {
-                        index = (el / stride) * stride + ((stride - 1) - (el % stride));
-                        offset = ((el & (stride - 1)) << 1) + 1;
-                    }
-
-                    // Calculates index of left and right element, which are candidates for exchange
-                    uint_t indexLeft = (index << 1) - (index & (stride - 1));
-                    uint_t indexRight = indexLeft + offset;
-                    if (indexRight >= arrayLength)
-                    {
-                        break;
-                    }
-
-                    if ((h_keys[indexLeft] > h_keys[indexRight]) ^ sortOrder)
-                    {
-                        data_t temp = h_keys[indexLeft];
-                        h_keys[indexLeft] = h_keys[indexRight];
-                        h_keys[indexRight] = temp;
-
-                        if (!sortingKeyOnly)
-                        {
-                            temp = h_values[indexLeft];
-                            h_values[indexLeft] = h_values[indexRight];
-                            h_values[indexRight] = temp;
-                        }
-                    }
-                }
+                uint_t tileStart = tileIdx * tileSize;
+                uint_t tileEnd = tileStart + tileSize < arrayLength ? tileStart + tileSize : arrayLength;
+                function(tileStart, tileEnd);
             }
+        });
+    }
+
+    /*
+    Performs STEPS of PHASE "subBlockSize" with strides from "stride" down to 1. STEPS with stride greater or equal
+    than tile size are performed over entire array (global merge), all other STEPS inside tiles (local merge).
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicMergeSequential(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t subBlockSize, uint_t stride, uint_t tileSize,
+        uint_t numThreads
+    )
+    {
+        // Global merge
+        for (; stride >= tileSize; stride >>= 1)
+        {
+            forEachTile(arrayLength, tileSize, numThreads, [&](uint_t tileStart, uint_t tileEnd)
+            {
+                bitonicStepNetwork<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, arrayLength, tileStart, tileEnd, stride, stride == subBlockSize
+                );
+            });
+        }
+
+        // Local merge
+        forEachTile(arrayLength, tileSize, numThreads, [&](uint_t tileStart, uint_t tileEnd)
+        {
+            bitonicMergeNetwork<sortOrder, sortingKeyOnly>(
+                h_keys + tileStart, sortingKeyOnly ? NULL : h_values + tileStart, tileEnd - tileStart, stride
+            );
+        });
+    }
+
+    /*
+    Sorts data sequentially with NORMALIZED bitonic sort. Vectors of keys (and values) are sorted and merged in
+    SIMD registers, if host supports AVX2/AVX-512 (see "bitonic_simd.h").
+    Array is processed in tiles, which fit into cache (the same way as parallel bitonic sort uses shared memory).
+    First all tiles are sorted. After that every PHASE performs STEPS with stride greater or equal than tile size
+    over entire array (global merge) and all STEPS with lower stride inside tiles (local merge). Tiles are
+    independent, so they can be processed by multiple threads.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicSortSequential(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t tileSize, uint_t numThreads
+    )
+    {
+        if (arrayLength <= 1)
+        {
+            return;
+        }
+
+        forEachTile(arrayLength, tileSize, numThreads, [&](uint_t tileStart, uint_t tileEnd)
+        {
+            bitonicSortNetwork<sortOrder, sortingKeyOnly>(
+                h_keys + tileStart, sortingKeyOnly ? NULL : h_values + tileStart, tileEnd - tileStart
+            );
+        });
+
+        for (uint_t subBlockSize = tileSize; subBlockSize < arrayLength; subBlockSize <<= 1)
+        {
+            bitonicMergeSequential<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, arrayLength, subBlockSize, subBlockSize, tileSize, numThreads
+            );
         }
     }
 
@@ -76,11 +124,11 @@ protected:
     {
         if (_sortOrder == ORDER_ASC)
         {
-            bitonicSortSequential<ORDER_ASC, true>(_h_keys, NULL, _arrayLength);
+            bitonicSortSequential<ORDER_ASC, true>(_h_keys, NULL, _arrayLength, _tileSizeKo, _numThreadsTiles);
         }
         else
         {
-            bitonicSortSequential<ORDER_DESC, true>(_h_keys, NULL, _arrayLength);
+            bitonicSortSequential<ORDER_DESC, true>(_h_keys, NULL, _arrayLength, _tileSizeKo, _numThreadsTiles);
         }
     }
 
@@ -92,11 +140,11 @@ protected:
     {
         if (_sortOrder == ORDER_ASC)
         {
-            bitonicSortSequential<ORDER_ASC, false>(_h_keys, _h_values, _arrayLength);
+            bitonicSortSequential<ORDER_ASC, false>(_h_keys, _h_values, _arrayLength, _tileSizeKv, _numThreadsTiles);
         }
         else
         {
-            bitonicSortSequential<ORDER_DESC, false>(_h_keys, _h_values, _arrayLength);
+            bitonicSortSequential<ORDER_DESC, false>(_h_keys, _h_values, _arrayLength, _tileSizeKv, _numThreadsTiles);
         }
     }
 
@@ -105,6 +153,23 @@ public:
     {
         return this->_sortName;
     }
+
+    /*
+    Sets the size of tiles for key-only and key-value sort. Has to be power of 2 and at least 32.
+    */
+    void setTileSize(uint_t tileSizeKo, uint_t tileSizeKv)
+    {
+        _tileSizeKo = tileSizeKo;
+        _tileSizeKv = tileSizeKv;
+    }
+
+    /*
+    Sets the number of host threads, which process independent tiles.
+    */
+    void setNumThreadsTiles(uint_t numThreads)
+    {
+        _numThreadsTiles = numThreads > 0 ? numThreads : 1;
+    }
 };
 
 #endif
@@ -0,0 +1,635 @@
+#ifndef BITONIC_SIMD_BITONIC_SORT_H
+#define BITONIC_SIMD_BITONIC_SORT_H
+
+#include "../Utils/data_types_common.h"
+#include "../Utils/host.h"
+#include "../Utils/simd.h"
+
+
+/*
+Kernels for NORMALIZED bitonic sort network on host. In normalized network all comparators put the element, which
+comes first in sort order, to the lower index. In the first STEP of every PHASE element "i" is compared with
+element "i ^ (2 * stride - 1)" (mirrored element in block), in all other STEPS with element "i ^ stride".
+Elements outside of array aren't compared, so network sorts arrays of any length.
+Elements are exchanged only if they are out of order, so values follow keys also for equal keys.
+
+SIMD kernels first sort every vector of 8 (AVX2) or 16 (AVX-512) keys in registers. After that every PHASE
+performs STEPS with strides greater or equal than vector length between pairs of vectors in memory and all STEPS
+with shorter strides in registers. Vectors, which aren't entirely located inside array, are processed with scalar
+code.
+*/
+
+/*
+Compares and exchanges elements on provided indexes. Index "index1" has to be lower than "index2".
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+inline void compareExchangeScalar(data_t *keys, data_t *values, uint_t index1, uint_t index2)
+{
+    data_t key1 = keys[index1];
+    data_t key2 = keys[index2];
+
+    if (sortOrder == ORDER_ASC ? key1 <= key2 : key1 >= key2)
+    {
+        return;
+    }
+
+    keys[index1] = key2;
+    keys[index2] = key1;
+
+    if (!sortingKeyOnly)
+    {
+        data_t temp = values[index1];
+        values[index1] = values[index2];
+        values[index2] = temp;
+    }
+}
+
+/*
+Performs one STEP of bitonic network with scalar code for elements with indexes in interval [start, end).
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+inline void bitonicStepScalar(
+    data_t *keys, data_t *values, uint_t arrayLength, uint_t start, uint_t end, uint_t stride,
+    bool isFirstStepOfPhase
+)
+{
+    uint_t partnerMask = isFirstStepOfPhase ? 2 * stride - 1 : stride;
+
+    for (uint_t index = start; index < end; index++)
+    {
+        uint_t partner = index ^ partnerMask;
+
+        if ((index & stride) == 0 && partner < arrayLength)
+        {
+            compareExchangeScalar<sortOrder, sortingKeyOnly>(keys, values, index, partner);
+        }
+    }
+}
+
+#if DATA_TYPE_BITS == 32
+
+/*
+Returns the mask of lanes, in which key from "keys1" comes after key from "keys2" in sort order.
+*/
+template <order_t sortOrder>
+TARGET_AVX2 inline __m256i isOutOfOrderAvx2(__m256i keys1, __m256i keys2)
+{
+    // Unsigned comparison isn't supported, so sign bits are flipped before signed comparison
+    __m256i signBit = _mm256_set1_epi32(0x80000000);
+    keys1 = _mm256_xor_si256(keys1, signBit);
+    keys2 = _mm256_xor_si256(keys2, signBit);
+
+    return sortOrder == ORDER_ASC ? _mm256_cmpgt_epi32(keys1, keys2) : _mm256_cmpgt_epi32(keys2, keys1);
+}
+
+/*
+Performs one STEP of bitonic network inside vector of 8 keys (and values). Every lane is compared with lane
+"lane ^ partnerMask". Lanes with set "strideBit" get the element, which comes later in sort order.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX2 inline void compareExchangeLanesAvx2(
+    __m256i &keys, __m256i &values, uint_t partnerMask, uint_t strideBit
+)
+{
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i permutation = _mm256_xor_si256(lanes, _mm256_set1_epi32(partnerMask));
+    __m256i isUpperLane = _mm256_cmpeq_epi32(
+        _mm256_and_si256(lanes, _mm256_set1_epi32(strideBit)), _mm256_set1_epi32(strideBit)
+    );
+    __m256i keysPartner = _mm256_permutevar8x32_epi32(keys, permutation);
+
+    if (sortingKeyOnly)
+    {
+        __m256i lo = sortOrder == ORDER_ASC
+            ? _mm256_min_epu32(keys, keysPartner)
+            : _mm256_max_epu32(keys, keysPartner);
+        __m256i hi = sortOrder == ORDER_ASC
+            ? _mm256_max_epu32(keys, keysPartner)
+            : _mm256_min_epu32(keys, keysPartner);
+        keys = _mm256_blendv_epi8(lo, hi, isUpperLane);
+        return;
+    }
+
+    // Lane takes element from partner lane, if the pair of elements is out of order
+    __m256i isExchanged = _mm256_blendv_epi8(
+        isOutOfOrderAvx2<sortOrder>(keys, keysPartner), isOutOfOrderAvx2<sortOrder>(keysPartner, keys),
+        isUpperLane
+    );
+    keys = _mm256_blendv_epi8(keys, keysPartner, isExchanged);
+    values = _mm256_blendv_epi8(
+        values, _mm256_permutevar8x32_epi32(values, permutation), isExchanged
+    );
+}
+
+/*
+Sorts every vector of 8 keys (and values) in interval [0, vectorsEnd) with bitonic network in registers.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX2 void sortVectorsAvx2(data_t *keys, data_t *values, uint_t vectorsEnd)
+{
+    const uint_t vectorLen = 8;
+    __m256i keysVector, valuesVector = _mm256_setzero_si256();
+
+    for (uint_t i = 0; i < vectorsEnd; i += vectorLen)
+    {
+        keysVector = _mm256_loadu_si256((__m256i*)(keys + i));
+        if (!sortingKeyOnly)
+        {
+            valuesVector = _mm256_loadu_si256((__m256i*)(values + i));
+        }
+
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 3, 2);
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 7, 4);
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 2, 2);
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+
+        _mm256_storeu_si256((__m256i*)(keys + i), keysVector);
+        if (!sortingKeyOnly)
+        {
+            _mm256_storeu_si256((__m256i*)(values + i), valuesVector);
+        }
+    }
+}
+
+/*
+Performs STEPS with strides 4, 2 and 1 on every vector of 8 keys (and values) in interval [0, vectorsEnd).
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX2 void mergeVectorsAvx2(data_t *keys, data_t *values, uint_t vectorsEnd)
+{
+    const uint_t vectorLen = 8;
+    __m256i keysVector, valuesVector = _mm256_setzero_si256();
+
+    for (uint_t i = 0; i < vectorsEnd; i += vectorLen)
+    {
+        keysVector = _mm256_loadu_si256((__m256i*)(keys + i));
+        if (!sortingKeyOnly)
+        {
+            valuesVector = _mm256_loadu_si256((__m256i*)(values + i));
+        }
+
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 4, 4);
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 2, 2);
+        compareExchangeLanesAvx2<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+
+        _mm256_storeu_si256((__m256i*)(keys + i), keysVector);
+        if (!sortingKeyOnly)
+        {
+            _mm256_storeu_si256((__m256i*)(values + i), valuesVector);
+        }
+    }
+}
+
+/*
+Compares and exchanges vector of 8 keys (and values) on "index1" with vector on "index2". If "isMirrored" is true,
+lane "i" of the first vector is compared with lane "7 - i" of the second vector.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX2 inline void compareExchangeVectorsAvx2(
+    data_t *keys, data_t *values, uint_t index1, uint_t index2, bool isMirrored
+)
+{
+    __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i keys1 = _mm256_loadu_si256((__m256i*)(keys + index1));
+    __m256i keys2 = _mm256_loadu_si256((__m256i*)(keys + index2));
+    keys2 = isMirrored ? _mm256_permutevar8x32_epi32(keys2, reverse) : keys2;
+
+    if (sortingKeyOnly)
+    {
+        __m256i lo = sortOrder == ORDER_ASC ? _mm256_min_epu32(keys1, keys2) : _mm256_max_epu32(keys1, keys2);
+        __m256i hi = sortOrder == ORDER_ASC ? _mm256_max_epu32(keys1, keys2) : _mm256_min_epu32(keys1, keys2);
+
+        _mm256_storeu_si256((__m256i*)(keys + index1), lo);
+        _mm256_storeu_si256(
+            (__m256i*)(keys + index2), isMirrored ? _mm256_permutevar8x32_epi32(hi, reverse) : hi
+        );
+        return;
+    }
+
+    __m256i values1 = _mm256_loadu_si256((__m256i*)(values + index1));
+    __m256i values2 = _mm256_loadu_si256((__m256i*)(values + index2));
+    values2 = isMirrored ? _mm256_permutevar8x32_epi32(values2, reverse) : values2;
+
+    __m256i isExchanged = isOutOfOrderAvx2<sortOrder>(keys1, keys2);
+    __m256i keysLo = _mm256_blendv_epi8(keys1, keys2, isExchanged);
+    __m256i keysHi = _mm256_blendv_epi8(keys2, keys1, isExchanged);
+    __m256i valuesLo = _mm256_blendv_epi8(values1, values2, isExchanged);
+    __m256i valuesHi = _mm256_blendv_epi8(values2, values1, isExchanged);
+
+    _mm256_storeu_si256((__m256i*)(keys + index1), keysLo);
+    _mm256_storeu_si256((__m256i*)(values + index1), valuesLo);
+    _mm256_storeu_si256(
+        (__m256i*)(keys + index2), isMirrored ? _mm256_permutevar8x32_epi32(keysHi, reverse) : keysHi
+    );
+    _mm256_storeu_si256(
+        (__m256i*)(values + index2), isMirrored ? _mm256_permutevar8x32_epi32(valuesHi, reverse) : valuesHi
+    );
+}
+
+/*
+Performs one STEP of bitonic network with stride greater or equal than 8 between pairs of vectors. Only elements
+with indexes in interval [start, end) are compared with their partners. Start has to be divisible by 8.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX2 void bitonicStepAvx2(
+    data_t *keys, data_t *values, uint_t arrayLength, uint_t start, uint_t end, uint_t stride,
+    bool isFirstStepOfPhase
+)
+{
+    const uint_t vectorLen = 8;
+
+    for (uint_t i = start; i < end && i + vectorLen <= arrayLength; i += vectorLen)
+    {
+        // Vectors in the second half of block are partners of vectors in the first half
+        if (i & stride)
+        {
+            continue;
+        }
+
+        // Start of the second vector. In the first step it contains mirrored elements of the first vector.
+        uint_t partner = isFirstStepOfPhase ? (i + vectorLen - 1) ^ (2 * stride - 1) : i + stride;
+
+        if (partner + vectorLen <= arrayLength)
+        {
+            compareExchangeVectorsAvx2<sortOrder, sortingKeyOnly>(keys, values, i, partner, isFirstStepOfPhase);
+        }
+        else if (partner < arrayLength)
+        {
+            bitonicStepScalar<sortOrder, sortingKeyOnly>(
+                keys, values, arrayLength, i, i + vectorLen, stride, isFirstStepOfPhase
+            );
+        }
+    }
+}
+
+/*
+Returns the mask of lanes, in which key from "keys1" comes after key from "keys2" in sort order.
+*/
+template <order_t sortOrder>
+TARGET_AVX512 inline __mmask16 isOutOfOrderAvx512(__m512i keys1, __m512i keys2)
+{
+    return _mm512_cmp_epu32_mask(keys1, keys2, sortOrder == ORDER_ASC ? _MM_CMPINT_NLE : _MM_CMPINT_LT);
+}
+
+/*
+Performs one STEP of bitonic network inside vector of 16 keys (and values). Every lane is compared with lane
+"lane ^ partnerMask". Lanes with set "strideBit" get the element, which comes later in sort order.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX512 inline void compareExchangeLanesAvx512(
+    __m512i &keys, __m512i &values, uint_t partnerMask, uint_t strideBit
+)
+{
+    __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i permutation = _mm512_xor_si512(lanes, _mm512_set1_epi32(partnerMask));
+    __mmask16 isUpperLane = _mm512_test_epi32_mask(lanes, _mm512_set1_epi32(strideBit));
+    __m512i keysPartner = _mm512_permutexvar_epi32(permutation, keys);
+
+    if (sortingKeyOnly)
+    {
+        __m512i lo = sortOrder == ORDER_ASC
+            ? _mm512_min_epu32(keys, keysPartner)
+            : _mm512_max_epu32(keys, keysPartner);
+        __m512i hi = sortOrder == ORDER_ASC
+            ? _mm512_max_epu32(keys, keysPartner)
+            : _mm512_min_epu32(keys, keysPartner);
+        keys = _mm512_mask_blend_epi32(isUpperLane, lo, hi);
+        return;
+    }
+
+    // Lane takes element from partner lane, if the pair of elements is out of order
+    __mmask16 isExchanged = (isOutOfOrderAvx512<sortOrder>(keys, keysPartner) & ~isUpperLane) |
+        (isOutOfOrderAvx512<sortOrder>(keysPartner, keys) & isUpperLane);
+    keys = _mm512_mask_blend_epi32(isExchanged, keys, keysPartner);
+    values = _mm512_mask_blend_epi32(isExchanged, values, _mm512_permutexvar_epi32(permutation, values));
+}
+
+/*
+Sorts every vector of 16 keys (and values) in interval [0, vectorsEnd) with bitonic network in registers.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX512 void sortVectorsAvx512(data_t *keys, data_t *values, uint_t vectorsEnd)
+{
+    const uint_t vectorLen = 16;
+    __m512i keysVector, valuesVector = _mm512_setzero_si512();
+
+    for (uint_t i = 0; i < vectorsEnd; i += vectorLen)
+    {
+        keysVector = _mm512_loadu_si512(keys + i);
+        if (!sortingKeyOnly)
+        {
+            valuesVector = _mm512_loadu_si512(values + i);
+        }
+
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 3, 2);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 7, 4);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 2, 2);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 15, 8);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 4, 4);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 2, 2);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+
+        _mm512_storeu_si512(keys + i, keysVector);
+        if (!sortingKeyOnly)
+        {
+            _mm512_storeu_si512(values + i, valuesVector);
+        }
+    }
+}
+
+/*
+Performs STEPS with strides 8, 4, 2 and 1 on every vector of 16 keys (and values) in interval [0, vectorsEnd).
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX512 void mergeVectorsAvx512(data_t *keys, data_t *values, uint_t vectorsEnd)
+{
+    const uint_t vectorLen = 16;
+    __m512i keysVector, valuesVector = _mm512_setzero_si512();
+
+    for (uint_t i = 0; i < vectorsEnd; i += vectorLen)
+    {
+        keysVector = _mm512_loadu_si512(keys + i);
+        if (!sortingKeyOnly)
+        {
+            valuesVector = _mm512_loadu_si512(values + i);
+        }
+
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 8, 8);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 4, 4);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 2, 2);
+        compareExchangeLanesAvx512<sortOrder, sortingKeyOnly>(keysVector, valuesVector, 1, 1);
+
+        _mm512_storeu_si512(keys + i, keysVector);
+        if (!sortingKeyOnly)
+        {
+            _mm512_storeu_si512(values + i, valuesVector);
+        }
+    }
+}
+
+/*
+Compares and exchanges vector of 16 keys (and values) on "index1" with vector on "index2". If "isMirrored" is
+true, lane "i" of the first vector is compared with lane "15 - i" of the second vector.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX512 inline void compareExchangeVectorsAvx512(
+    data_t *keys, data_t *values, uint_t index1, uint_t index2, bool isMirrored
+)
+{
+    __m512i reverse = _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    __m512i keys1 = _mm512_loadu_si512(keys + index1);
+    __m512i keys2 = _mm512_loadu_si512(keys + index2);
+    keys2 = isMirrored ? _mm512_permutexvar_epi32(reverse, keys2) : keys2;
+
+    if (sortingKeyOnly)
+    {
+        __m512i lo = sortOrder == ORDER_ASC ? _mm512_min_epu32(keys1, keys2) : _mm512_max_epu32(keys1, keys2);
+        __m512i hi = sortOrder == ORDER_ASC ? _mm512_max_epu32(keys1, keys2) : _mm512_min_epu32(keys1, keys2);
+
+        _mm512_storeu_si512(keys + index1, lo);
+        _mm512_storeu_si512(keys + index2, isMirrored ? _mm512_permutexvar_epi32(reverse, hi) : hi);
+        return;
+    }
+
+    __m512i values1 = _mm512_loadu_si512(values + index1);
+    __m512i values2 = _mm512_loadu_si512(values + index2);
+    values2 = isMirrored ? _mm512_permutexvar_epi32(reverse, values2) : values2;
+
+    __mmask16 isExchanged = isOutOfOrderAvx512<sortOrder>(keys1, keys2);
+    __m512i keysLo = _mm512_mask_blend_epi32(isExchanged, keys1, keys2);
+    __m512i keysHi = _mm512_mask_blend_epi32(isExchanged, keys2, keys1);
+    __m512i valuesLo = _mm512_mask_blend_epi32(isExchanged, values1, values2);
+    __m512i valuesHi = _mm512_mask_blend_epi32(isExchanged, values2, values1);
+
+    _mm512_storeu_si512(keys + index1, keysLo);
+    _mm512_storeu_si512(values + index1, valuesLo);
+    _mm512_storeu_si512(keys + index2, isMirrored ? _mm512_permutexvar_epi32(reverse, keysHi) : keysHi);
+    _mm512_storeu_si512(values + index2, isMirrored ? _mm512_permutexvar_epi32(reverse, valuesHi) : valuesHi);
+}
+
+/*
+Performs one STEP of bitonic network with stride greater or equal than 16 between pairs of vectors. Only elements
+with indexes in interval [start, end) are compared with their partners. Start has to be divisible by 16.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+TARGET_AVX512 void bitonicStepAvx512(
+    data_t *keys, data_t *values, uint_t arrayLength, uint_t start, uint_t end, uint_t stride,
+    bool isFirstStepOfPhase
+)
+{
+    const uint_t vectorLen = 16;
+
+    for (uint_t i = start; i < end && i + vectorLen <= arrayLength; i += vectorLen)
+    {
+        // Vectors in the second half of block are partners of vectors in the first half
+        if (i & stride)
+        {
+            continue;
+        }
+
+        // Start of the second vector. In the first step it contains mirrored elements of the first vector.
+        uint_t partner = isFirstStepOfPhase ? (i + vectorLen - 1) ^ (2 * stride - 1) : i + stride;
+
+        if (partner + vectorLen <= arrayLength)
+        {
+            compareExchangeVectorsAvx512<sortOrder, sortingKeyOnly>(
+                keys, values, i, partner, isFirstStepOfPhase
+            );
+        }
+        else if (partner < arrayLength)
+        {
+            bitonicStepScalar<sortOrder, sortingKeyOnly>(
+                keys, values, arrayLength, i, i + vectorLen, stride, isFirstStepOfPhase
+            );
+        }
+    }
+}
+
+/*
+Performs all STEPS with strides from "stride" down to 1 (not the first STEP of PHASE). Steps with strides lower
+than vector length are performed in registers (AVX2 for 8, AVX-512 for 16 elements).
+*/
+template <order_t sortOrder, bool sortingKeyOnly, uint_t vectorLen>
+void bitonicMergeVectorized(data_t *keys, data_t *values, uint_t arrayLength, uint_t stride)
+{
+    // Elements after the last whole vector are processed with scalar code
+    uint_t vectorsEnd = arrayLength - arrayLength % vectorLen;
+
+    for (; stride >= vectorLen; stride >>= 1)
+    {
+        if (vectorLen == 16)
+        {
+            bitonicStepAvx512<sortOrder, sortingKeyOnly>(keys, values, arrayLength, 0, arrayLength, stride, false);
+        }
+        else
+        {
+            bitonicStepAvx2<sortOrder, sortingKeyOnly>(keys, values, arrayLength, 0, arrayLength, stride, false);
+        }
+    }
+
+    if (stride < vectorLen / 2)
+    {
+        vectorsEnd = 0;
+    }
+    else if (vectorLen == 16)
+    {
+        mergeVectorsAvx512<sortOrder, sortingKeyOnly>(keys, values, vectorsEnd);
+    }
+    else
+    {
+        mergeVectorsAvx2<sortOrder, sortingKeyOnly>(keys, values, vectorsEnd);
+    }
+    for (; stride > 0; stride >>= 1)
+    {
+        bitonicStepScalar<sortOrder, sortingKeyOnly>(
+            keys, values, arrayLength, vectorsEnd, arrayLength, stride, false
+        );
+    }
+}
+
+/*
+Sorts keys (and values) with bitonic network, where vectors of "vectorLen" elements are sorted and merged in
+registers (AVX2 for 8, AVX-512 for 16 elements).
+*/
+template <order_t sortOrder, bool sortingKeyOnly, uint_t vectorLen>
+void bitonicSortVectorized(data_t *keys, data_t *values, uint_t arrayLength)
+{
+    // Elements after the last whole vector are processed with scalar code
+    uint_t vectorsEnd = arrayLength - arrayLength % vectorLen;
+
+    if (vectorLen == 16)
+    {
+        sortVectorsAvx512<sortOrder, sortingKeyOnly>(keys, values, vectorsEnd);
+    }
+    else
+    {
+        sortVectorsAvx2<sortOrder, sortingKeyOnly>(keys, values, vectorsEnd);
+    }
+    for (uint_t subBlockSize = 1; subBlockSize < vectorLen; subBlockSize <<= 1)
+    {
+        for (uint_t stride = subBlockSize; stride > 0; stride >>= 1)
+        {
+            bitonicStepScalar<sortOrder, sortingKeyOnly>(
+                keys, values, arrayLength, vectorsEnd, arrayLength, stride, stride == subBlockSize
+            );
+        }
+    }
+
+    for (uint_t subBlockSize = vectorLen; subBlockSize < arrayLength; subBlockSize <<= 1)
+    {
+        if (vectorLen == 16)
+        {
+            bitonicStepAvx512<sortOrder, sortingKeyOnly>(
+                keys, values, arrayLength, 0, arrayLength, subBlockSize, true
+            );
+        }
+        else
+        {
+            bitonicStepAvx2<sortOrder, sortingKeyOnly>(keys, values, arrayLength, 0, arrayLength, subBlockSize, true);
+        }
+
+        bitonicMergeVectorized<sortOrder, sortingKeyOnly, vectorLen>(keys, values, arrayLength, subBlockSize / 2);
+    }
+}
+
+#endif
+
+/*
+Sorts keys (and values) with normalized bitonic network. The widest SIMD kernels supported by host are used.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+void bitonicSortNetwork(data_t *keys, data_t *values, uint_t arrayLength)
+{
+#if DATA_TYPE_BITS == 32
+    static const bool isAvx512Supported = isHostAvx512Supported();
+    static const bool isAvx2Supported = isHostAvx2Supported();
+
+    if (isAvx512Supported)
+    {
+        bitonicSortVectorized<sortOrder, sortingKeyOnly, 16>(keys, values, arrayLength);
+        return;
+    }
+    if (isAvx2Supported)
+    {
+        bitonicSortVectorized<sortOrder, sortingKeyOnly, 8>(keys, values, arrayLength);
+        return;
+    }
+#endif
+
+    for (uint_t subBlockSize = 1; subBlockSize < arrayLength; subBlockSize <<= 1)
+    {
+        for (uint_t stride = subBlockSize; stride > 0; stride >>= 1)
+        {
+            bitonicStepScalar<sortOrder, sortingKeyOnly>(
+                keys, values, arrayLength, 0, arrayLength, stride, stride == subBlockSize
+            );
+        }
+    }
+}
+
+/*
+Performs all STEPS of bitonic network with strides from "stride" down to 1 (bitonic merge without the first STEP of
+PHASE). The widest SIMD kernels supported by host are used.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+void bitonicMergeNetwork(data_t *keys, data_t *values, uint_t arrayLength, uint_t stride)
+{
+#if DATA_TYPE_BITS == 32
+    static const bool isAvx512Supported = isHostAvx512Supported();
+    static const bool isAvx2Supported = isHostAvx2Supported();
+
+    if (isAvx512Supported)
+    {
+        bitonicMergeVectorized<sortOrder, sortingKeyOnly, 16>(keys, values, arrayLength, stride);
+        return;
+    }
+    if (isAvx2Supported)
+    {
+        bitonicMergeVectorized<sortOrder, sortingKeyOnly, 8>(keys, values, arrayLength, stride);
+        return;
+    }
+#endif
+
+    for (; stride > 0; stride >>= 1)
+    {
+        bitonicStepScalar<sortOrder, sortingKeyOnly>(keys, values, arrayLength, 0, arrayLength, stride, false);
+    }
+}
+
+/*
+Performs one STEP of bitonic network for elements with indexes in interval [start, end). Stride has to be greater or
+equal than 16 and start has to be divisible by 16. The widest SIMD kernels supported by host are used.
+*/
+template <order_t sortOrder, bool sortingKeyOnly>
+void bitonicStepNetwork(
+    data_t *keys, data_t *values, uint_t arrayLength, uint_t start, uint_t end, uint_t stride,
+    bool isFirstStepOfPhase
+)
+{
+#if DATA_TYPE_BITS == 32
+    static const bool isAvx512Supported = isHostAvx512Supported();
+    static const bool isAvx2Supported = isHostAvx2Supported();
+
+    if (isAvx512Supported)
+    {
+        bitonicStepAvx512<sortOrder, sortingKeyOnly>(
+            keys, values, arrayLength, start, end, stride, isFirstStepOfPhase
+        );
+        return;
+    }
+    if (isAvx2Supported)
+    {
+        bitonicStepAvx2<sortOrder, sortingKeyOnly>(keys, values, arrayLength, start, end, stride, isFirstStepOfPhase);
+        return;
+    }
+#endif
+
+    bitonicStepScalar<sortOrder, sortingKeyOnly>(keys, values, arrayLength, start, end, stride, isFirstStepOfPhase);
+}
+
+#endif
@@ -9,6 +9,30 @@ _KO: Key-only
 _KV: Key-value
 */
 
+/* ------------- SEQUENTIAL BITONIC SORT ------------- */
+
+// Size of tiles, in which all STEPS with lower stride are performed while tile is resident in cache (L1/L2).
+// Only STEPS with greater or equal stride are performed over entire array. Has to be power of 2 and at least 32.
+#if DATA_TYPE_BITS == 32
+#define TILE_SIZE_BITONIC_SORT_SEQUENTIAL_KO (1 << 13)
+#define TILE_SIZE_BITONIC_SORT_SEQUENTIAL_KV (1 << 12)
+#else
+#define TILE_SIZE_BITONIC_SORT_SEQUENTIAL_KO (1 << 12)
+#define TILE_SIZE_BITONIC_SORT_SEQUENTIAL_KV (1 << 11)
+#endif
+// How many host threads process independent tiles. If 0, the number of concurrent threads supported by host is used.
+#define NUM_THREADS_BITONIC_SORT_SEQUENTIAL 1
+
+
+/* ----------- MULTITHREADED BITONIC SORT ------------ */
+
+// How many host threads are used. If 0, the number of concurrent threads supported by host is used.
+#define NUM_THREADS_BITONIC_SORT_MULTITHREADED 0
+// Array is divided into chunks (power of 2, at least tile size), so that there are at least this many chunks per
+// thread. STEPS with stride lower than chunk size are performed by every thread on its chunks without barriers.
+#define MIN_CHUNKS_PER_THREAD_BITONIC_SORT_MULTITHREADED 4
+
+
 /* ---------------- BITONIC SORT KERNEL -------------- */
 // KO: key only, KV: key-value
 
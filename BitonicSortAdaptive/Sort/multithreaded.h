@@ -0,0 +1,452 @@
+#ifndef BITONIC_SORT_ADAPTIVE_MULTITHREADED_H
+#define BITONIC_SORT_ADAPTIVE_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "../data_types.h"
+
+
+/*
+Class for multithreaded adaptive bitonic sort on host.
+
+Instead of bitonic tree bitonic sequences are represented with intervals (IBR - interval based representation),
+same as in parallel adaptive bitonic sort. Interval consists of 2 parts of array (offset and length), which
+together form a bitonic sequence. In STEP of bitonic merge the index, where exchanges begin, is found with binary
+search and interval is split into 2 intervals of half length without moving any elements.
+
+Merges of different intervals are independent. If there are not enough bitonic sequences for all threads,
+intervals are split by all threads one STEP at a time (with barrier in between), until there are enough of them.
+After that every thread merges its contiguous range of intervals linearly into buffer. This way every PHASE
+requires O(n) comparisons and entire sort O(n log n) comparisons.
+
+Array isn't padded to the next power of 2. The last bitonic sequence in PHASE can be shorter than others - its
+halves can have different lengths (or second half can be empty). Interval is always split, so that lower interval
+is full (except if the whole interval is shorter), which means all intervals start at the same offsets as if array
+was padded and intervals after the end of array are empty.
+*/
+class BitonicSortAdaptiveMultithreaded : public SortSequential
+{
+protected:
+    std::string _sortName = "Bitonic sort adaptive multithreaded";
+    // Buffers for keys and values, to which intervals are merged
+    data_t *_h_keysBuffer = NULL;
+    data_t *_h_valuesBuffer = NULL;
+    // Number of host threads used for sort
+    uint_t _numThreads = NUM_THREADS_BITONIC_SORT_ADAPTIVE_MULTITHREADED > 0
+        ? NUM_THREADS_BITONIC_SORT_ADAPTIVE_MULTITHREADED
+        : getNumHostThreads();
+
+    /*
+    Method for allocating memory needed both for key only and key-value sort.
+    */
+    void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
+
+        _h_keysBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_keysBuffer));
+        checkMallocError(_h_keysBuffer);
+        _h_valuesBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_valuesBuffer));
+        checkMallocError(_h_valuesBuffer);
+    }
+
+    /*
+    From provided interval and index returns the index of element in array. Index has to be lower than interval
+    span.
+    */
+    uint_t getIntervalIndex(interval_t interval, uint_t index)
+    {
+        return index < interval.length0 ? interval.offset0 + index : interval.offset1 + index - interval.length0;
+    }
+
+    /*
+    Returns the initial interval of bitonic sequence, which is merged in PHASE with provided sub-block half length.
+    In every odd sequence intervals have to be reversed, because every sub-block half is sorted in opposite
+    direction than previous one. Halves of the last sequence are truncated to array length.
+    */
+    interval_t getInitInterval(uint_t sequenceIndex, uint_t subBlockHalfLen, uint_t arrayLength)
+    {
+        uint_t offset0 = sequenceIndex * 2 * subBlockHalfLen;
+        uint_t offset1 = offset0 + subBlockHalfLen;
+        uint_t length0 = offset1 <= arrayLength ? subBlockHalfLen : arrayLength - offset0;
+        uint_t length1 = offset1 >= arrayLength ? 0 : (offset1 + subBlockHalfLen <= arrayLength
+            ? subBlockHalfLen : arrayLength - offset1);
+        interval_t interval;
+
+        interval.offset0 = sequenceIndex % 2 ? offset1 : offset0;
+        interval.offset1 = sequenceIndex % 2 ? offset0 : offset1;
+        interval.length0 = sequenceIndex % 2 ? length1 : length0;
+        interval.length1 = sequenceIndex % 2 ? length0 : length1;
+
+        return interval;
+    }
+
+    /*
+    Finds the index q, which is an index, where the exchanges in the bitonic sequence begin. All elements after
+    index q have to be exchanged. Bitonic sequence boundaries are provided with interval. Template parameter
+    "mergeOrder" is the order, in which bitonic sequence is being merged.
+
+    Lower half of sequence contains "lowerLen" elements. If both halves have the same length, this is the same as
+    the STEP of bitonic merge. Otherwise element "i" is compared with element "i + upperLen", which is the partner
+    of element "i" in the merge of first part with second part (read from its end).
+    */
+    template <order_t mergeOrder>
+    uint_t binarySearchInterval(data_t *keys, interval_t interval, uint_t lowerLen)
+    {
+        uint_t upperLen = interval.length0 + interval.length1 - lowerLen;
+        // Lower half contains at most "length0" elements from first part and at most "length1" from second part
+        uint_t indexStart = lowerLen <= interval.length1 ? 0 : lowerLen - interval.length1;
+        uint_t indexEnd = lowerLen <= interval.length0 ? lowerLen : interval.length0;
+
+        while (indexStart < indexEnd)
+        {
+            uint_t index = indexStart + (indexEnd - indexStart) / 2;
+            data_t el0 = keys[getIntervalIndex(interval, index)];
+            data_t el1 = keys[getIntervalIndex(interval, index + upperLen)];
+
+            if (mergeOrder == ORDER_ASC ? el0 < el1 : el0 > el1)
+            {
+                indexStart = index + 1;
+            }
+            else
+            {
+                indexEnd = index;
+            }
+        }
+
+        return indexStart;
+    }
+
+    /*
+    Splits interval of bitonic sequence into intervals of lower and upper half of sequence after the STEP of
+    bitonic merge. Lower interval contains "subBlockHalfLen" elements, or all elements if interval is shorter
+    (this happens only in the last sequence of array, which isn't power of 2).
+    */
+    template <order_t mergeOrder>
+    void splitInterval(
+        data_t *keys, interval_t interval, uint_t subBlockHalfLen, interval_t &intervalLower,
+        interval_t &intervalUpper
+    )
+    {
+        uint_t intervalLen = interval.length0 + interval.length1;
+        uint_t lowerLen = subBlockHalfLen <= intervalLen ? subBlockHalfLen : intervalLen;
+        uint_t q = binarySearchInterval<mergeOrder>(keys, interval, lowerLen);
+
+        intervalLower.offset0 = interval.offset0;
+        intervalLower.length0 = q;
+        intervalLower.offset1 = interval.offset1 + interval.length1 - lowerLen + q;
+        intervalLower.length1 = lowerLen - q;
+
+        intervalUpper.offset0 = interval.offset0 + q;
+        intervalUpper.length0 = interval.length0 - q;
+        intervalUpper.offset1 = interval.offset1;
+        intervalUpper.length1 = q + interval.length1 - lowerLen;
+    }
+
+    /*
+    Splits interval of bitonic sequence into intervals of lower and upper half of sequence. Order of merge is
+    determined by the index of bitonic sequence, to which interval belongs.
+    */
+    template <order_t sortOrder>
+    void splitInterval(
+        data_t *keys, interval_t interval, uint_t subBlockHalfLen, uint_t sequenceIndex,
+        interval_t &intervalLower, interval_t &intervalUpper
+    )
+    {
+        if ((sortOrder == ORDER_ASC) ^ (sequenceIndex & 1))
+        {
+            splitInterval<ORDER_ASC>(keys, interval, subBlockHalfLen, intervalLower, intervalUpper);
+        }
+        else
+        {
+            splitInterval<ORDER_DESC>(keys, interval, subBlockHalfLen, intervalLower, intervalUpper);
+        }
+    }
+
+    /*
+    Merges bitonic sequence provided with interval and stores it to buffer at provided offset. First part of
+    interval is always sorted in merge order and second part in opposite order (this holds for initial intervals
+    and is preserved by splitting), so it is enough to merge first part from its start and second part from its end.
+    */
+    template <order_t mergeOrder, bool sortingKeyOnly>
+    void bitonicMergeInterval(
+        data_t *keys, data_t *values, data_t *keysBuffer, data_t *valuesBuffer, interval_t interval, uint_t offset
+    )
+    {
+        uint_t index0 = interval.offset0;
+        uint_t end0 = interval.offset0 + interval.length0;
+        // Second part is read from its end. Index is shifted by one, so it doesn't underflow.
+        uint_t index1 = interval.offset1 + interval.length1;
+        uint_t end1 = interval.offset1;
+
+        for (; index0 < end0 && index1 > end1; offset++)
+        {
+            data_t key0 = keys[index0];
+            data_t key1 = keys[index1 - 1];
+            bool isFirst = mergeOrder == ORDER_ASC ? key0 <= key1 : key0 >= key1;
+
+            keysBuffer[offset] = isFirst ? key0 : key1;
+            if (!sortingKeyOnly)
+            {
+                valuesBuffer[offset] = values[isFirst ? index0 : index1 - 1];
+            }
+
+            index0 += isFirst;
+            index1 -= !isFirst;
+        }
+
+        for (; index0 < end0; index0++, offset++)
+        {
+            keysBuffer[offset] = keys[index0];
+            if (!sortingKeyOnly)
+            {
+                valuesBuffer[offset] = values[index0];
+            }
+        }
+        for (; index1 > end1; index1--, offset++)
+        {
+            keysBuffer[offset] = keys[index1 - 1];
+            if (!sortingKeyOnly)
+            {
+                valuesBuffer[offset] = values[index1 - 1];
+            }
+        }
+    }
+
+    /*
+    Executes the first PHASE of bitonic sort (sorts pairs of elements) in place. Pairs are sorted in alternating
+    directions.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicSortPairsInPlace(data_t *keys, data_t *values, uint_t pairIdxStart, uint_t pairIdxEnd)
+    {
+        for (uint_t i = pairIdxStart; i < pairIdxEnd; i++)
+        {
+            data_t key0 = keys[2 * i];
+            data_t key1 = keys[2 * i + 1];
+            bool isAsc = (sortOrder == ORDER_ASC) ^ (i & 1);
+
+            if (isAsc ? key0 <= key1 : key0 >= key1)
+            {
+                continue;
+            }
+
+            keys[2 * i] = key1;
+            keys[2 * i + 1] = key0;
+
+            if (!sortingKeyOnly)
+            {
+                data_t temp = values[2 * i];
+                values[2 * i] = values[2 * i + 1];
+                values[2 * i + 1] = temp;
+            }
+        }
+    }
+
+    /*
+    Sorts data with multithreaded adaptive bitonic sort. Every PHASE merges from primary array to buffer (or vice
+    versa). If the number of PHASES is odd, the first PHASE is executed in place, so sorted data always ends up in
+    primary array.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicSortAdaptiveMultithreaded(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t arrayLength,
+        uint_t numThreads
+    )
+    {
+        if (arrayLength <= 1)
+        {
+            return;
+        }
+
+        uint_t phasesAll = log2((double)nextPowerOf2(arrayLength));
+        uint_t minNumIntervals = numThreads * MIN_INTERVALS_PER_THREAD_BITONIC_SORT_ADAPTIVE_MULTITHREADED;
+        numThreads = numThreads < arrayLength / 2 ? numThreads : arrayLength / 2;
+
+        // Intervals are generated only if there are less bitonic sequences than "minNumIntervals", so their number
+        // never exceeds "2 * minNumIntervals"
+        std::vector<interval_t> intervals(2 * minNumIntervals), intervalsBuffer(2 * minNumIntervals);
+        SpinBarrier barrier(numThreads);
+
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            // Every thread exchanges its own copy of pointers after every STEP (or PHASE)
+            data_t *keys = h_keys, *values = h_values;
+            data_t *keysBuffer = h_keysBuffer, *valuesBuffer = h_valuesBuffer;
+            interval_t *intervalsInput = intervals.data(), *intervalsOutput = intervalsBuffer.data();
+            uint_t phase = 1;
+
+            if (phasesAll % 2 == 1)
+            {
+                bitonicSortPairsInPlace<sortOrder, sortingKeyOnly>(
+                    keys, values, getThreadChunkStart(threadIndex, numThreads, arrayLength / 2),
+                    getThreadChunkEnd(threadIndex, numThreads, arrayLength / 2)
+                );
+                barrier.wait();
+                phase++;
+            }
+
+            for (; phase <= phasesAll; phase++)
+            {
+                uint_t subBlockHalfLen = 1 << (phase - 1);
+                uint_t numIntervals = (arrayLength - 1) / (2 * subBlockHalfLen) + 1;
+                // How many times intervals were split by all threads
+                uint_t numSplits = 0;
+                // If there are enough bitonic sequences, their intervals aren't stored
+                bool isIntervalsStored = numIntervals < minNumIntervals;
+
+                if (isIntervalsStored)
+                {
+                    uint_t intervalIdxStart = getThreadChunkStart(threadIndex, numThreads, numIntervals);
+                    uint_t intervalIdxEnd = getThreadChunkEnd(threadIndex, numThreads, numIntervals);
+
+                    for (uint_t i = intervalIdxStart; i < intervalIdxEnd; i++)
+                    {
+                        intervalsInput[i] = getInitInterval(i, subBlockHalfLen, arrayLength);
+                    }
+                    barrier.wait();
+
+                    // All threads split intervals one STEP at a time, until there are enough intervals. Intervals,
+                    // which lie after the end of array, are empty and they are not processed anymore.
+                    for (; numIntervals < minNumIntervals && subBlockHalfLen > 1; numSplits++)
+                    {
+                        intervalIdxStart = getThreadChunkStart(threadIndex, numThreads, numIntervals);
+                        intervalIdxEnd = getThreadChunkEnd(threadIndex, numThreads, numIntervals);
+
+                        for (uint_t i = intervalIdxStart; i < intervalIdxEnd; i++)
+                        {
+                            splitInterval<sortOrder>(
+                                keys, intervalsInput[i], subBlockHalfLen, i >> numSplits,
+                                intervalsOutput[2 * i], intervalsOutput[2 * i + 1]
+                            );
+                        }
+                        barrier.wait();
+
+                        interval_t *tempIntervals = intervalsInput;
+                        intervalsInput = intervalsOutput;
+                        intervalsOutput = tempIntervals;
+
+                        subBlockHalfLen /= 2;
+                        numIntervals = (arrayLength - 1) / (2 * subBlockHalfLen) + 1;
+                    }
+                }
+
+                uint_t intervalIdxStart = getThreadChunkStart(threadIndex, numThreads, numIntervals);
+                uint_t intervalIdxEnd = getThreadChunkEnd(threadIndex, numThreads, numIntervals);
+
+                // Every thread independently merges its intervals
+                for (uint_t i = intervalIdxStart; i < intervalIdxEnd; i++)
+                {
+                    uint_t sequenceIndex = i >> numSplits;
+                    interval_t interval = isIntervalsStored
+                        ? intervalsInput[i]
+                        : getInitInterval(i, subBlockHalfLen, arrayLength);
+
+                    if ((sortOrder == ORDER_ASC) ^ (sequenceIndex & 1))
+                    {
+                        bitonicMergeInterval<ORDER_ASC, sortingKeyOnly>(
+                            keys, values, keysBuffer, valuesBuffer, interval, 2 * i * subBlockHalfLen
+                        );
+                    }
+                    else
+                    {
+                        bitonicMergeInterval<ORDER_DESC, sortingKeyOnly>(
+                            keys, values, keysBuffer, valuesBuffer, interval, 2 * i * subBlockHalfLen
+                        );
+                    }
+                }
+                barrier.wait();
+
+                data_t *temp = keys;
+                keys = keysBuffer;
+                keysBuffer = temp;
+
+                if (!sortingKeyOnly)
+                {
+                    temp = values;
+                    values = valuesBuffer;
+                    valuesBuffer = temp;
+                }
+            }
+        });
+    }
+
+    /*
+    Wrapper for multithreaded adaptive bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortAdaptiveMultithreaded<ORDER_ASC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _arrayLength, _numThreads
+            );
+        }
+        else
+        {
+            bitonicSortAdaptiveMultithreaded<ORDER_DESC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _arrayLength, _numThreads
+            );
+        }
+    }
+
+    /*
+    Wrapper for multithreaded adaptive bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortAdaptiveMultithreaded<ORDER_ASC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength, _numThreads
+            );
+        }
+        else
+        {
+            bitonicSortAdaptiveMultithreaded<ORDER_DESC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength, _numThreads
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Sets the number of host threads used for sort.
+    */
+    void setNumThreads(uint_t numThreads)
+    {
+        _numThreads = numThreads > 0 ? numThreads : 1;
+    }
+
+    /*
+    Method for destroying memory needed for sort. For sort testing purposes this method is public.
+    */
+    void memoryDestroy()
+    {
+        if (_arrayLength == 0)
+        {
+            return;
+        }
+
+        SortSequential::memoryDestroy();
+
+        free(_h_keysBuffer);
+        free(_h_valuesBuffer);
+    }
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "../../Utils/data_types_common.h"
@@ -13,62 +14,58 @@
 
 /*
 Class for sequential adaptive bitonic sort.
-TODO: reimplement without padding. In previous Git commits it is partially reimplemented without padding.
+
+Bitonic tree is stored in contiguous arena of nodes, which is allocated only once. Children are addressed with
+32-bit indexes in arena. At the beginning of sort bitonic tree is laid out in in-order, which means that node
+with index "i" holds the i-th element of array and its children are "i - stride" and "i + stride". During merges
+only child indexes are exchanged, so tree is re-initialized with one pass over arena before every sort.
+
+Array isn't padded to the next power of 2. Instead it is divided into pieces with power of 2 lengths (according
+to set bits of array length), which are laid out in arena one after another in decreasing length. Every piece is
+a separate bitonic tree and its last node is its spare node. Pieces are sorted independently with adaptive bitonic
+sort and then merged with linear merges, starting with the shortest pieces.
+
+Adaptive bitonic merge works only for distinct sequences. That's why every node also holds the element's index in
+original (not sorted) array, which breaks ties between equal keys. Because of that sort is also stable.
 */
 class BitonicSortAdaptiveSequential : public SortSequential
 {
 protected:
     std::string _sortName = "Bitonic sort adaptive sequential";
-    // Root node of bitonic tree
-    node_t *_root = NULL;
-    // Spare node of bitonic tree (right most element of array)
-    node_t *_spare = NULL;
+    // Arena of bitonic tree nodes (last node of every piece is its spare node)
+    node_t *_h_bitonicTree = NULL;
+    // Buffer for keys, which is used when pieces are merged
+    data_t *_h_keysBuffer = NULL;
+    // Copy of values, from which values are gathered after sort according to element indexes. It is also used as
+    // buffer when pieces are merged.
+    data_t *_h_valuesBuffer = NULL;
 
     /*
     For debugging purposes prints out bitonic tree. Not to be called directly - bottom method calls it.
     */
-    void printBitonicTree(node_t *node, uint_t level)
+    void printBitonicTree(node_t *bitonicTree, uint_t node, uint_t height, uint_t level)
     {
-        if (node == NULL)
-        {
-            return;
-        }
-
         for (uint_t i = 0; i < level; i++)
         {
             printf("  ");
         }
 
-        printf("|%d\n", node->key);
+        printf("|%d\n", bitonicTree[node].key);
 
-        level++;
-        printBitonicTree(node->left, level);
-        printBitonicTree(node->right, level);
-    }
-
-    /*
-    For debugging purposes prints out bitonic tree.
-    */
-    void printBitonicTree(node_t *root)
-    {
-        printBitonicTree(root, 0);
+        if (height > 0)
+        {
+            printBitonicTree(bitonicTree, bitonicTree[node].left, height - 1, level + 1);
+            printBitonicTree(bitonicTree, bitonicTree[node].right, height - 1, level + 1);
+        }
     }
 
     /*
-    Requires root node and stride (at beginning this is "<array_length> / 4").
+    For debugging purposes prints out bitonic tree of the first (longest) piece.
     */
-    void constructBitonicTree(node_t *parent, int_t stride)
+    void printBitonicTree(uint_t arrayLength)
     {
-        if (stride == 0)
-        {
-            return;
-        }
-
-        parent->left = new node_t();
-        parent->right = new node_t();
-
-        constructBitonicTree(parent->left, stride / 2);
-        constructBitonicTree(parent->right, stride / 2);
+        uint_t pieceLength = previousPowerOf2(arrayLength);
+        printBitonicTree(_h_bitonicTree, pieceLength / 2 - 1, log2((double)pieceLength) - 1, 0);
     }
 
     /*
@@ -78,52 +75,30 @@ protected:
     {
         SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
 
-        _root = new Node();
-        _spare = new Node();
-
-        constructBitonicTree(_root, nextPowerOf2(arrayLength) / 4);
+        _h_bitonicTree = (node_t*)malloc(arrayLength * sizeof(*_h_bitonicTree));
+        checkMallocError(_h_bitonicTree);
+        _h_keysBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_keysBuffer));
+        checkMallocError(_h_keysBuffer);
+        _h_valuesBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_valuesBuffer));
+        checkMallocError(_h_valuesBuffer);
     }
 
     /*
-    Fills bitonic tree with keys from array and generates unique values.
+    Fills bitonic tree with keys from array and lays it out in in-order. Because every piece starts at offset
+    divisible by its length, the same formula for children is valid for all pieces.
     */
-    template <data_t minMaxValue>
-    void fillBitonicTreeKeyOnly(data_t *keys, node_t *node, uint_t arrayLength, data_t arrayIndex, int_t stride)
+    void fillBitonicTree(data_t *h_keys, node_t *bitonicTree, uint_t arrayLength)
     {
-        if (node == NULL)
+        for (uint_t i = 0; i < arrayLength; i++)
         {
-            return;
-        }
-
-        node->key = arrayIndex < arrayLength ? keys[arrayIndex] : minMaxValue;
-        node->value = arrayIndex;
-
-        fillBitonicTreeKeyOnly<minMaxValue>(keys, node->left, arrayLength, arrayIndex - stride, stride / 2);
-        fillBitonicTreeKeyOnly<minMaxValue>(keys, node->right, arrayLength, arrayIndex + stride, stride / 2);
-    }
+            // Stride between node and its children is half of the lowest set bit of "i + 1" (0 for leaves)
+            uint_t stride = ((i + 1) & ~i) / 2;
 
-    /*
-    Fills bitonic tree with keys and values.
-    */
-    template <data_t minMaxValue>
-    void fillBitonicTreeKeyValue(
-        data_t *h_keys, data_t *h_values, node_t *node, uint_t arrayLength, uint_t arrayIndex, int_t stride
-    )
-    {
-        if (node == NULL)
-        {
-            return;
+            bitonicTree[i].key = h_keys[i];
+            bitonicTree[i].index = i;
+            bitonicTree[i].left = i - stride;
+            bitonicTree[i].right = i + stride;
         }
-
-        node->key = arrayIndex < arrayLength ? h_keys[arrayIndex] : minMaxValue;
-        node->value = arrayIndex < arrayLength ? h_values[arrayIndex] : arrayIndex;
-
-        fillBitonicTreeKeyValue<minMaxValue>(
-            h_keys, h_values, node->left, arrayLength, arrayIndex - stride, stride / 2
-        );
-        fillBitonicTreeKeyValue<minMaxValue>(
-            h_keys, h_values, node->right, arrayLength, arrayIndex + stride, stride / 2
-        );
     }
 
     /*
@@ -133,295 +108,362 @@ protected:
     {
         SortSequential::memoryCopyBeforeSort(h_keys, h_values, arrayLength);
 
-        uint_t arrayLenPowerOf2 = nextPowerOf2(arrayLength);
-        uint_t rootIndex = arrayLenPowerOf2 / 2 - 1;
-        bool sortingKeyOnly = h_values == NULL;
-
-        if (sortingKeyOnly)
-        {
-            if (_sortOrder == ORDER_ASC)
-            {
-                fillBitonicTreeKeyOnly<MAX_VAL>(h_keys, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4);
-            }
-            else
-            {
-                fillBitonicTreeKeyOnly<MIN_VAL>(h_keys, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4);
-            }
-        }
-        else
-        {
-            if (_sortOrder == ORDER_ASC)
-            {
-                fillBitonicTreeKeyValue<MAX_VAL>(
-                    h_keys, h_values, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4
-                );
-            }
-            else
-            {
-                fillBitonicTreeKeyValue<MIN_VAL>(
-                    h_keys, h_values, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4
-                );
-            }
-        }
-
-        if (arrayLength == arrayLenPowerOf2)
-        {
-            _spare->key = h_keys[arrayLength - 1];
-            _spare->value = sortingKeyOnly ? arrayLength - 1 : h_values[arrayLength - 1];
-        }
-        else
-        {
-            _spare->key = _sortOrder == ORDER_ASC ? MAX_VAL : MIN_VAL;
-            _spare->value = arrayLenPowerOf2 - 1;
-        }
-    }
-
-    /*
-    Converts bitonic tree to array of keys. Doesn't put value of spare node into array.
-    Not to be called directly - bottom function calls it.
-    */
-    void bitonicTreeToArrayKeyOnly(data_t *h_keys, node_t *node, uint_t arrayLength, uint_t arrayIndex, uint_t stride)
-    {
-        if (arrayIndex < arrayLength)
-        {
-            h_keys[arrayIndex] = node->key;
-        }
-
-        if (stride == 0)
+        if (arrayLength <= 1)
         {
             return;
         }
 
-        bitonicTreeToArrayKeyOnly(h_keys, node->left, arrayLength, arrayIndex - stride, stride / 2);
-        if (arrayIndex < arrayLength)
+        fillBitonicTree(h_keys, _h_bitonicTree, arrayLength);
+
+        if (h_values != NULL)
         {
-            bitonicTreeToArrayKeyOnly(h_keys, node->right, arrayLength, arrayIndex + stride, stride / 2);
+            memcpy(_h_valuesBuffer, h_values, arrayLength * sizeof(*_h_valuesBuffer));
         }
     }
 
     /*
-    Converts bitonic tree to array of keys and values. Doesn't put value of spare node into array.
-    Not to be called directly - bottom function calls it.
+    Converts bitonic tree of piece to array of keys and values with iterative in-order traversal. Values are
+    gathered from "valuesSource" according to element indexes. If sorting keys only, than "h_values" contains NULL.
     */
-    void bitonicTreeToArrayKeyValue(
-        data_t *h_keys, data_t *h_values, node_t *node, uint_t arrayLength, uint_t arrayIndex, uint_t stride
+    void bitonicTreeToArray(
+        data_t *h_keys, data_t *h_values, data_t *valuesSource, node_t *bitonicTree, uint_t pieceOffset,
+        uint_t pieceLength
     )
     {
-        if (arrayIndex < arrayLength)
-        {
-            h_keys[arrayIndex] = node->key;
-            h_values[arrayIndex] = node->value;
-        }
-
-        if (stride == 0)
-        {
-            return;
-        }
-
-        bitonicTreeToArrayKeyValue(h_keys, h_values, node->left, arrayLength, arrayIndex - stride, stride / 2);
-        if (arrayIndex < arrayLength)
-        {
-            bitonicTreeToArrayKeyValue(h_keys, h_values, node->right, arrayLength, arrayIndex + stride, stride / 2);
-        }
-    }
+        uint_t stackNodes[sizeof(uint_t) * 8 + 1];
+        uint_t stackHeights[sizeof(uint_t) * 8 + 1];
+        uint_t stackSize = 0;
 
-    /*
-    Copies data from device to host. If sorting keys only, than "h_values" contains NULL.
-    */
-    virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
-    {
-        SortSequential::memoryCopyAfterSort(h_keys, h_values, arrayLength);
-        bool sortingKeyOnly = h_values == NULL;
+        uint_t node = pieceOffset + pieceLength / 2 - 1;
+        uint_t height = pieceLength > 1 ? log2((double)pieceLength) - 1 : 0;
+        bool hasNode = true;
+        // Spare node (last node of piece) isn't part of the tree
+        uint_t spare = pieceOffset + pieceLength - 1;
 
-        if (arrayLength == 1)
+        for (uint_t arrayIndex = pieceOffset; arrayIndex < spare; arrayIndex++)
         {
-            h_keys[0] = _root->key;
-            if (!sortingKeyOnly)
+            // Descends to the left most leaf of current subtree
+            while (hasNode)
             {
-                h_values[0] = _root->value;
+                stackNodes[stackSize] = node;
+                stackHeights[stackSize++] = height;
+                hasNode = height > 0;
+                node = bitonicTree[node].left;
+                height--;
             }
-            return;
-        }
-
-        uint_t arrayLenPower2 = nextPowerOf2(arrayLength);
 
-        if (sortingKeyOnly)
-        {
-            bitonicTreeToArrayKeyOnly(h_keys, _root, arrayLength, arrayLenPower2 / 2 - 1, arrayLenPower2 / 4);
-        }
-        else
-        {
-            bitonicTreeToArrayKeyValue(
-                h_keys, h_values, _root, arrayLength, arrayLenPower2 / 2 - 1, arrayLenPower2 / 4
-            );
-        }
+            stackSize--;
+            node = stackNodes[stackSize];
+            height = stackHeights[stackSize];
 
-        // If array was padded, then there is no need to insert a spare node in last element of array.
-        if (arrayLength < arrayLenPower2)
-        {
-            return;
-        }
+            h_keys[arrayIndex] = bitonicTree[node].key;
+            if (h_values != NULL)
+            {
+                h_values[arrayIndex] = valuesSource[bitonicTree[node].index];
+            }
 
-        // Inserts spare node
-        h_keys[arrayLength - 1] = _spare->key;
-        if (!sortingKeyOnly)
-        {
-            h_values[arrayLength - 1] = _spare->value;
+            hasNode = height > 0;
+            node = bitonicTree[node].right;
+            height--;
         }
-    }
 
-    /*
-    Deletes bitonic tree.
-    */
-    void deleteBitonicTree(node_t *node)
-    {
-        if (node == NULL)
+        h_keys[spare] = bitonicTree[spare].key;
+        if (h_values != NULL)
         {
-            return;
+            h_values[spare] = valuesSource[bitonicTree[spare].index];
         }
-
-        deleteBitonicTree(node->left);
-        deleteBitonicTree(node->right);
-        delete node;
     }
 
     /*
-    Swaps node's key and value properties.
+    Swaps node's key and index properties.
     */
     void swapNodeKeyValue(node_t *node1, node_t *node2)
     {
-        data_t temp;
-
-        temp = node1->key;
+        data_t tempKey = node1->key;
         node1->key = node2->key;
-        node2->key = temp;
+        node2->key = tempKey;
 
-        temp = node1->value;
-        node1->value = node2->value;
-        node2->value = temp;
+        uint32_t tempIndex = node1->index;
+        node1->index = node2->index;
+        node2->index = tempIndex;
     }
 
     /*
-    Swaps left nodes.
+    Swaps left child indexes.
     */
     void swapLeftNode(node_t *node1, node_t *node2)
     {
-        node_t *node = node1->left;
+        uint32_t temp = node1->left;
         node1->left = node2->left;
-        node2->left = node;
+        node2->left = temp;
     }
 
     /*
-    Swaps right nodes.
+    Swaps right child indexes.
     */
     void swapRightNode(node_t *node1, node_t *node2)
     {
-        node_t *node = node1->right;
+        uint32_t temp = node1->right;
         node1->right = node2->right;
-        node2->right = node;
+        node2->right = temp;
     }
 
     /*
-    Executes adaptive bitonic merge.
-
-    Adaptive bitonic merge works only for dictinct sequences. In case of duplicates in sequence values are compared
-    by their position in original (not sorted) array.
+    Compares nodes according to sort order. Ties between keys are resolved according to element position in
+    original (not sorted) array. If "isReversed" is true, nodes are compared in exactly the opposite order,
+    otherwise bitonic sequences wouldn't be formed.
     */
-    template <order_t sortOrder>
-    void bitonicMerge(node_t *root, node_t *spare)
+    template <order_t sortOrder, bool isReversed>
+    bool isNodeGreater(node_t *node1, node_t *node2)
     {
-        // Compares keys according to sort order
-        bool rightExchange = sortOrder == ORDER_ASC ? (root->key > spare->key) : (root->key < spare->key);
-
-        // In case of duplicates, ties are resolved according to element position in original unsorted array
-        if (!rightExchange)
+        if (isReversed)
         {
-            rightExchange = root->key == spare->key && (
-                sortOrder == ORDER_ASC ? root->value > spare->value : root->value < spare->value
-            );
+            node_t *temp = node1;
+            node1 = node2;
+            node2 = temp;
         }
 
-        if (rightExchange)
-        {
-            swapNodeKeyValue(root, spare);
-        }
+        bool isKeyGreater = sortOrder == ORDER_ASC ? node1->key > node2->key : node1->key < node2->key;
+        return isKeyGreater || (node1->key == node2->key && node1->index > node2->index);
+    }
 
-        node_t *leftNode = root->left;
-        node_t *rightNode = root->right;
+    /*
+    Executes adaptive bitonic merge of tree with provided root, spare node and height. Instead of recursion
+    pairs (root, spare) of subtrees, which still have to be merged, are kept on stack.
+    */
+    template <order_t sortOrder, bool isReversed>
+    void bitonicMerge(node_t *bitonicTree, uint_t root, uint_t spare, uint_t height)
+    {
+        uint_t stackRoots[sizeof(uint_t) * 8 + 1];
+        uint_t stackSpares[sizeof(uint_t) * 8 + 1];
+        uint_t stackHeights[sizeof(uint_t) * 8 + 1];
+        uint_t stackSize = 0;
 
-        while (leftNode != NULL)
+        stackRoots[stackSize] = root;
+        stackSpares[stackSize] = spare;
+        stackHeights[stackSize++] = height;
+
+        while (stackSize > 0)
         {
-            // Compares keys according to sort order
-            bool elementExchange = sortOrder == ORDER_ASC ? (leftNode->key > rightNode->key) : (leftNode->key < rightNode->key);
+            stackSize--;
+            root = stackRoots[stackSize];
+            spare = stackSpares[stackSize];
+            height = stackHeights[stackSize];
+
+            node_t *rootNode = &bitonicTree[root];
+            node_t *spareNode = &bitonicTree[spare];
 
-            // In case of duplicates, ties are resolved according to element position in original unsorted array
-            if (!elementExchange)
+            bool rightExchange = isNodeGreater<sortOrder, isReversed>(rootNode, spareNode);
+            if (rightExchange)
             {
-                elementExchange = leftNode->key == rightNode->key && (
-                    sortOrder == ORDER_ASC ? leftNode->value > rightNode->value : leftNode->value < rightNode->value
-                );
+                swapNodeKeyValue(rootNode, spareNode);
             }
 
-            if (rightExchange)
+            if (height == 0)
+            {
+                continue;
+            }
+
+            node_t *leftNode = &bitonicTree[rootNode->left];
+            node_t *rightNode = &bitonicTree[rootNode->right];
+
+            for (uint_t level = height; level > 0; level--)
             {
+                bool elementExchange = isNodeGreater<sortOrder, isReversed>(leftNode, rightNode);
+
                 if (elementExchange)
                 {
                     swapNodeKeyValue(leftNode, rightNode);
-                    swapRightNode(leftNode, rightNode);
 
-                    leftNode = leftNode->left;
-                    rightNode = rightNode->left;
+                    // If root and spare were exchanged, right children are exchanged, otherwise left children
+                    if (rightExchange)
+                    {
+                        swapRightNode(leftNode, rightNode);
+                    }
+                    else
+                    {
+                        swapLeftNode(leftNode, rightNode);
+                    }
+                }
+
+                // Continues in left subtrees if both or none of the exchanges were performed, otherwise in right
+                if (rightExchange == elementExchange)
+                {
+                    leftNode = &bitonicTree[leftNode->left];
+                    rightNode = &bitonicTree[rightNode->left];
                 }
                 else
                 {
-                    leftNode = leftNode->right;
-                    rightNode = rightNode->right;
+                    leftNode = &bitonicTree[leftNode->right];
+                    rightNode = &bitonicTree[rightNode->right];
                 }
             }
-            else
+
+            stackRoots[stackSize] = rootNode->right;
+            stackSpares[stackSize] = spare;
+            stackHeights[stackSize++] = height - 1;
+
+            stackRoots[stackSize] = rootNode->left;
+            stackSpares[stackSize] = root;
+            stackHeights[stackSize++] = height - 1;
+        }
+    }
+
+    /*
+    Executes adaptive bitonic sort on bitonic tree of piece laid out in in-order. Subtree with its spare node covers
+    a block of piece, which is sorted by merging its two halves. Instead of recursion blocks are merged iteratively
+    in post-order (same order as in recursion), so small blocks are merged while they are still in cache. Every
+    block is sorted in reversed order if its index has odd number of set bits (in recursion the right half of block
+    is sorted in opposite direction than its parent block).
+    */
+    template <order_t sortOrder>
+    void bitonicSortAdaptivePiece(node_t *bitonicTree, uint_t pieceOffset, uint_t pieceLength)
+    {
+        for (uint_t pairIndex = 0; pairIndex < pieceLength / 2; pairIndex++)
+        {
+            // Merges all blocks, which end with current pair of elements
+            for (uint_t height = 0; ((uint64_t)2 << height) <= pieceLength; height++)
             {
-                if (elementExchange)
+                if (((pairIndex + 1) & (((uint_t)1 << height) - 1)) != 0)
                 {
-                    swapNodeKeyValue(leftNode, rightNode);
-                    swapLeftNode(leftNode, rightNode);
+                    break;
+                }
+
+                uint_t blockSize = (uint_t)2 << height;
+                uint_t blockIndex = ((pairIndex + 1) >> height) - 1;
+                uint_t root = pieceOffset + blockIndex * blockSize + blockSize / 2 - 1;
+                uint_t spare = pieceOffset + blockIndex * blockSize + blockSize - 1;
+                bool isReversed = false;
+
+                for (uint_t i = blockIndex; i > 0; i &= i - 1)
+                {
+                    isReversed = !isReversed;
+                }
 
-                    leftNode = leftNode->right;
-                    rightNode = rightNode->right;
+                if (isReversed)
+                {
+                    bitonicMerge<sortOrder, true>(bitonicTree, root, spare, height);
                 }
                 else
                 {
-                    leftNode = leftNode->left;
-                    rightNode = rightNode->left;
+                    bitonicMerge<sortOrder, false>(bitonicTree, root, spare, height);
                 }
             }
         }
+    }
 
-        if (root->left != NULL)
+    /*
+    Merges sorted piece "[pieceOffset, restOffset)" with sorted rest of array "[restOffset, arrayLength)" from input
+    arrays into output arrays. On equal keys elements from piece are taken first, so merge is stable.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergePieces(
+        data_t *keysInput, data_t *valuesInput, data_t *keysOutput, data_t *valuesOutput, uint_t pieceOffset,
+        uint_t restOffset, uint_t arrayLength
+    )
+    {
+        uint_t indexPiece = pieceOffset;
+        uint_t indexRest = restOffset;
+        uint_t indexOutput = pieceOffset;
+
+        while (indexPiece < restOffset && indexRest < arrayLength)
+        {
+            data_t keyPiece = keysInput[indexPiece];
+            data_t keyRest = keysInput[indexRest];
+            bool isRestFirst = sortOrder == ORDER_ASC ? keyRest < keyPiece : keyRest > keyPiece;
+
+            if (isRestFirst)
+            {
+                keysOutput[indexOutput] = keyRest;
+                if (!sortingKeyOnly)
+                {
+                    valuesOutput[indexOutput] = valuesInput[indexRest];
+                }
+                indexRest++;
+            }
+            else
+            {
+                keysOutput[indexOutput] = keyPiece;
+                if (!sortingKeyOnly)
+                {
+                    valuesOutput[indexOutput] = valuesInput[indexPiece];
+                }
+                indexPiece++;
+            }
+            indexOutput++;
+        }
+
+        for (; indexPiece < restOffset; indexPiece++, indexOutput++)
+        {
+            keysOutput[indexOutput] = keysInput[indexPiece];
+            if (!sortingKeyOnly)
+            {
+                valuesOutput[indexOutput] = valuesInput[indexPiece];
+            }
+        }
+        for (; indexRest < arrayLength; indexRest++, indexOutput++)
         {
-            bitonicMerge<sortOrder>(root->left, root);
-            bitonicMerge<sortOrder>(root->right, spare);
+            keysOutput[indexOutput] = keysInput[indexRest];
+            if (!sortingKeyOnly)
+            {
+                valuesOutput[indexOutput] = valuesInput[indexRest];
+            }
         }
     }
 
     /*
-    Executes adaptive bitonic sort on provided bitonic tree. Requires root node of bitonic tree, spare node
-    (at beginning this is node with last array element with no children and parents) and sort order.
+    Sorts array with adaptive bitonic sort without padding. Pieces of bitonic tree are sorted and converted to
+    arrays, after which they are merged from the shortest piece to the longest one. Merges alternate between
+    array and buffer, so every piece is converted into the array, from which it is merged, and the last merge
+    outputs into original array. Values of piece are gathered from the array, which isn't its destination -
+    "valuesBuffer" holds a copy of all values and original array still holds values of the piece.
     */
-    template <order_t sortOrder>
-    void bitonicSortAdaptiveSequential(node_t *root, node_t *spare)
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicSortAdaptiveSequential(
+        data_t *h_keys, data_t *h_values, data_t *keysBuffer, data_t *valuesBuffer, node_t *bitonicTree,
+        uint_t arrayLength
+    )
     {
-        if (root->left == NULL)
+        if (arrayLength <= 1)
         {
-            if (sortOrder == ORDER_ASC ? (root->key > spare->key) : (root->key < spare->key))
+            return;
+        }
+
+        uint_t pieceOffsets[sizeof(uint_t) * 8 + 1];
+        uint_t numPieces = 0;
+
+        for (uint_t pieceLength = previousPowerOf2(arrayLength); pieceLength > 0; pieceLength >>= 1)
+        {
+            if ((arrayLength & pieceLength) == 0)
             {
-                swapNodeKeyValue(root, spare);
+                continue;
             }
+
+            uint_t pieceOffset = arrayLength & ~(2 * pieceLength - 1);
+            bitonicSortAdaptivePiece<sortOrder>(bitonicTree, pieceOffset, pieceLength);
+
+            // Piece "i" is merged from buffer if "i" is even, except the last piece, which is merged from the same
+            // array as the previous piece. The only piece (array length is power of 2) is written to original array.
+            bool isLastPiece = (arrayLength & (pieceLength - 1)) == 0;
+            bool toBuffer = isLastPiece ? numPieces % 2 == 1 : numPieces % 2 == 0;
+
+            bitonicTreeToArray(
+                toBuffer ? keysBuffer : h_keys, sortingKeyOnly ? NULL : (toBuffer ? valuesBuffer : h_values),
+                toBuffer ? h_values : valuesBuffer, bitonicTree, pieceOffset, pieceLength
+            );
+            pieceOffsets[numPieces++] = pieceOffset;
         }
-        else
+
+        for (uint_t i = numPieces - 1; i > 0; i--)
         {
-            bitonicSortAdaptiveSequential<sortOrder>(root->left, root);
-            bitonicSortAdaptiveSequential<(order_t)!sortOrder>(root->right, spare);
-            bitonicMerge<sortOrder>(root, spare);
+            // Merge of piece "i - 1" outputs to original array if "i - 1" is even
+            bool toBuffer = (i - 1) % 2 == 1;
+
+            mergePieces<sortOrder, sortingKeyOnly>(
+                toBuffer ? h_keys : keysBuffer, toBuffer ? h_values : valuesBuffer,
+                toBuffer ? keysBuffer : h_keys, toBuffer ? valuesBuffer : h_values,
+                pieceOffsets[i - 1], pieceOffsets[i], arrayLength
+            );
         }
     }
 
@@ -433,20 +475,36 @@ protected:
     {
         if (_sortOrder == ORDER_ASC)
         {
-            bitonicSortAdaptiveSequential<ORDER_ASC>(_root, _spare);
+            bitonicSortAdaptiveSequential<ORDER_ASC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_bitonicTree, _arrayLength
+            );
         }
         else
         {
-            bitonicSortAdaptiveSequential<ORDER_DESC>(_root, _spare);
+            bitonicSortAdaptiveSequential<ORDER_DESC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_bitonicTree, _arrayLength
+            );
         }
     }
 
     /*
     Wrapper for sequential adaptive bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
     */
     void sortKeyValue()
     {
-        sortKeyOnly();
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortAdaptiveSequential<ORDER_ASC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_bitonicTree, _arrayLength
+            );
+        }
+        else
+        {
+            bitonicSortAdaptiveSequential<ORDER_DESC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_bitonicTree, _arrayLength
+            );
+        }
     }
 
 public:
@@ -467,8 +525,9 @@ public:
 
         SortSequential::memoryDestroy();
 
-        deleteBitonicTree(_root);
-        delete _spare;
+        free(_h_bitonicTree);
+        free(_h_keysBuffer);
+        free(_h_valuesBuffer);
     }
 };
 
@@ -9,6 +9,15 @@ _KO:  Key-only
 _KV:  Key-value
 */
 
+/* ------- MULTITHREADED ADAPTIVE BITONIC SORT ------- */
+
+// How many host threads are used. If 0, the number of concurrent threads supported by host is used.
+#define NUM_THREADS_BITONIC_SORT_ADAPTIVE_MULTITHREADED 0
+// Intervals of bitonic sequences are split by all threads (one recursion level at a time), until there are at
+// least this many intervals per thread. After that every thread merges its intervals independently.
+#define MIN_INTERVALS_PER_THREAD_BITONIC_SORT_ADAPTIVE_MULTITHREADED 4
+
+
 /* ------------------ PADDING KERNEL ----------------- */
 
 // How many threads are used per on thread block for padding. Has to be power of 2.
@@ -20,32 +20,18 @@ struct Interval
 };
 
 /*
-Represents a Node in bitonic tree needed for adaptive bitonic sort.
+Represents a Node in bitonic tree needed for adaptive bitonic sort. Nodes are stored in contiguous arena and
+children are addressed with their 32-bit index in arena.
 
 Adaptive bitonic sort works only for distinct sequences. If sequence isn't distinct, ties can be broken by the
-element's original position in array. This is why this structure contains property "value" alongside property "key".
+element's original position in array. This is why this structure contains property "index" alongside property "key".
 */
 struct Node
 {
-    data_t key;    // Holds value from array
-    data_t value;   // Holds an index of element in original (not sorted) array
-    node_t *left;
-    node_t *right;
-
-    Node(data_t key, data_t value, node_t *left, node_t *right)
-    {
-
-        this->key = key;
-        this->value = value;
-        this->left = left;
-        this->right = right;
-    }
-
-    Node(data_t key, data_t value) : Node(key, value, NULL, NULL) {}
-
-    Node(data_t key) : Node(key, key, NULL, NULL) {}
-
-    Node() : Node(NULL, NULL, NULL, NULL) {}
+    data_t key;       // Holds value from array
+    uint32_t index;   // Holds an index of element in original (not sorted) array
+    uint32_t left;    // Index of left child in arena
+    uint32_t right;   // Index of right child in arena
 };
 
 #endif
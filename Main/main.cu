@@ -15,15 +15,27 @@
 #include "../Utils/sort_interface.h"
 
 #include "../BitonicSort/Sort/sequential.h"
+#include "../BitonicSort/Sort/multithreaded.h"
 #include "../BitonicSort/Sort/parallel.h"
 #include "../BitonicSortMultistep/Sort/parallel.h"
 #include "../BitonicSortAdaptive/Sort/sequential.h"
+#include "../BitonicSortAdaptive/Sort/multithreaded.h"
 #include "../BitonicSortAdaptive/Sort/parallel.h"
 #include "../MergeSort/Sort/sequential.h"
+#include "../MergeSort/Sort/sequential_natural.h"
+#include "../MergeSort/Sort/multiway.h"
+#include "../MergeSort/Sort/sequential_in_place.h"
+#include "../MergeSort/Sort/multithreaded.h"
 #include "../MergeSort/Sort/parallel.h"
 #include "../Quicksort/Sort/sequential.h"
+#include "../Quicksort/Sort/multithreaded.h"
+#include "../Quicksort/Sort/multithreaded_global.h"
 #include "../Quicksort/Sort/parallel.h"
 #include "../RadixSort/Sort/sequential.h"
+#include "../RadixSort/Sort/sequential_adaptive.h"
+#include "../RadixSort/Sort/hybrid.h"
+#include "../RadixSort/Sort/sequential_in_place.h"
+#include "../RadixSort/Sort/multithreaded.h"
 #include "../RadixSort/Sort/parallel.h"
 #include "../SampleSort/Sort/sequential.h"
 #include "../SampleSort/Sort/parallel.h"
@@ -62,15 +74,27 @@ int main(int argc, char **argv)
     // Sorting algorithms
     std::vector<SortSequential*> sorts;
     sorts.push_back(new BitonicSortSequential());
+    sorts.push_back(new BitonicSortMultithreaded());
     sorts.push_back(new BitonicSortParallel());
     sorts.push_back(new BitonicSortMultistepParallel());
     sorts.push_back(new BitonicSortAdaptiveSequential());
+    sorts.push_back(new BitonicSortAdaptiveMultithreaded());
     sorts.push_back(new BitonicSortAdaptiveParallel());
     sorts.push_back(new MergeSortSequential());
+    sorts.push_back(new MergeSortSequentialNatural());
+    sorts.push_back(new MergeSortMultiway());
+    sorts.push_back(new MergeSortSequentialInPlace());
+    sorts.push_back(new MergeSortMultithreaded());
     sorts.push_back(new MergeSortParallel());
     sorts.push_back(new QuicksortSequential());
+    sorts.push_back(new QuicksortMultithreaded());
+    sorts.push_back(new QuicksortMultithreadedGlobal());
     sorts.push_back(new QuicksortParallel());
     sorts.push_back(new RadixSortSequential());
+    sorts.push_back(new RadixSortSequentialAdaptive());
+    sorts.push_back(new RadixSortHybrid());
+    sorts.push_back(new RadixSortSequentialInPlace());
+    sorts.push_back(new RadixSortMultithreaded());
     sorts.push_back(new RadixSortParallel());
     sorts.push_back(new SampleSortSequential());
     sorts.push_back(new SampleSortParallel());
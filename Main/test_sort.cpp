@@ -271,6 +271,9 @@ void generateSortTestResults(
     printf("> %s\n", sort->getSortName(sortingKeyOnly).c_str());
     printTableHeader();
 
+    // Number of bytes, which didn't have to be copied from buffer after sort in all repetitions
+    uint64_t bytesCopySaved = 0;
+
     // Tests sort for key only
     for (uint_t iter = 0; iter < testRepetitions; iter++)
     {
@@ -278,9 +281,15 @@ void generateSortTestResults(
             sort, distribution, keys, keysCopy, values, arrayLength, sortOrder, interval, iter, testRepetitions,
             sortingKeyOnly
         );
+        bytesCopySaved += sort->getBytesCopySaved();
     }
 
     printTableLine();
+
+    if (bytesCopySaved > 0)
+    {
+        printf("> Copy after sort saved: %.2lf MB per sort\n", bytesCopySaved / 1024.0 / 1024.0 / testRepetitions);
+    }
 }
 
 /*
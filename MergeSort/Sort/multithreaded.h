@@ -0,0 +1,248 @@
+#ifndef MERGE_SORT_MULTITHREADED_H
+#define MERGE_SORT_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "sequential.h"
+
+
+/*
+Class for multithreaded merge sort on host.
+In every phase the output array is divided into equal chunks, one per thread. Chunk boundaries can fall inside
+merged blocks, so every thread finds the positions in odd and even block, from which its part of merge starts and
+ends, with binary search (co-rank / merge path). This way all threads are busy also in last phases, when only a
+few merges remain. It is the host counterpart of ranks used in parallel merge sort. Sort is stable.
+*/
+class MergeSortMultithreaded : public MergeSortSequential
+{
+protected:
+    std::string _sortName = "Merge sort multithreaded";
+    // Number of host threads used for sort
+    uint_t _numThreads = NUM_THREADS_MULTITHREADED_MERGE > 0 ? NUM_THREADS_MULTITHREADED_MERGE : getNumHostThreads();
+
+    /*
+    Returns the number of threads used for sort. Short arrays are sorted with fewer threads.
+    */
+    uint_t getNumThreadsUsed(uint_t arrayLength, uint_t minElemsPerThread)
+    {
+        uint_t numThreads = arrayLength / minElemsPerThread;
+        numThreads = numThreads < _numThreads ? numThreads : _numThreads;
+        return numThreads > 0 ? numThreads : 1;
+    }
+
+    /*
+    Returns the number of elements from odd block, which are located in the first "mergeOffset" elements of merged
+    block (co-rank). In case of equal elements, elements from odd block are placed first, which keeps sort stable.
+    */
+    template <order_t sortOrder>
+    uint_t getCoRank(data_t *oddKeys, uint_t oddLen, data_t *evenKeys, uint_t evenLen, uint_t mergeOffset)
+    {
+        uint_t indexStart = mergeOffset > evenLen ? mergeOffset - evenLen : 0;
+        uint_t indexEnd = mergeOffset < oddLen ? mergeOffset : oddLen;
+
+        while (indexStart < indexEnd)
+        {
+            uint_t oddIndex = (indexStart + indexEnd) / 2;
+            data_t oddElement = oddKeys[oddIndex];
+            data_t evenElement = evenKeys[mergeOffset - oddIndex - 1];
+
+            // If odd element is merged before even element, it is located in the first "mergeOffset" elements
+            if (sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement)
+            {
+                indexStart = oddIndex + 1;
+            }
+            else
+            {
+                indexEnd = oddIndex;
+            }
+        }
+
+        return indexStart;
+    }
+
+    /*
+    Merges part of odd and even block, which outputs elements from "outputStart" to "outputEnd" (relative to start
+    of merged block). Outputs the result to buffer array.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeBlockPart(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t arrayLength,
+        uint_t sortedBlockSize, uint_t blockIndex, uint_t outputStart, uint_t outputEnd
+    )
+    {
+        uint_t subBlockSize = sortedBlockSize / 2;
+        uint_t blockStart = blockIndex * sortedBlockSize;
+        uint_t oddEnd = getEndIndex(blockStart, subBlockSize, arrayLength);
+        uint_t evenStart = oddEnd;
+        uint_t evenEnd = getEndIndex(evenStart, subBlockSize, arrayLength);
+        uint_t oddLen = oddEnd - blockStart;
+        uint_t evenLen = evenEnd - evenStart;
+
+        // Start indexes of merge are found with co-rank, if merge doesn't start at the beginning of block
+        uint_t oddIndex = blockStart;
+        if (outputStart > 0)
+        {
+            oddIndex += getCoRank<sortOrder>(h_keys + blockStart, oddLen, h_keys + evenStart, evenLen, outputStart);
+        }
+        uint_t evenIndex = evenStart + outputStart - (oddIndex - blockStart);
+
+        for (uint_t mergeIndex = blockStart + outputStart; mergeIndex < blockStart + outputEnd; mergeIndex++)
+        {
+            bool isOddMerged = evenIndex == evenEnd;
+
+            if (oddIndex < oddEnd && evenIndex < evenEnd)
+            {
+                data_t oddElement = h_keys[oddIndex];
+                data_t evenElement = h_keys[evenIndex];
+                isOddMerged = sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement;
+            }
+
+            uint_t index = isOddMerged ? oddIndex++ : evenIndex++;
+
+            h_keysBuffer[mergeIndex] = h_keys[index];
+            if (!sortingKeyOnly)
+            {
+                h_valuesBuffer[mergeIndex] = h_values[index];
+            }
+        }
+    }
+
+    /*
+    Sorts data with multithreaded merge sort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeSortMultithreaded(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t numThreads,
+        uint_t arrayLength
+    )
+    {
+        if (arrayLength <= 1)
+        {
+            return;
+        }
+
+        uint_t arrayLenPower2 = nextPowerOf2(arrayLength);
+        uint_t sortedBlockSize = 2;
+
+        // Sorted array has to be located in primary array after the last phase
+        if (isFirstMergePhaseInPlace(arrayLength, false))
+        {
+            runHostThreads(numThreads, [&](uint_t threadIndex)
+            {
+                // Chunks start at even index, so pairs aren't split between threads
+                uint_t chunkStart = getThreadChunkStart(threadIndex, numThreads, arrayLength) & ~1;
+                uint_t chunkEnd = getThreadChunkEnd(threadIndex, numThreads, arrayLength);
+                chunkEnd = chunkEnd == arrayLength ? chunkEnd : chunkEnd & ~1;
+
+                mergePairsInPlace<sortOrder, sortingKeyOnly>(
+                    h_keys + chunkStart, sortingKeyOnly ? NULL : h_values + chunkStart, chunkEnd - chunkStart
+                );
+            });
+            sortedBlockSize *= 2;
+        }
+
+        // Log(arrayLength) phases of merge sort
+        for (; sortedBlockSize <= arrayLenPower2; sortedBlockSize *= 2)
+        {
+            // Every thread merges equal part of output array, which can span over multiple blocks
+            runHostThreads(numThreads, [&](uint_t threadIndex)
+            {
+                uint_t chunkStart = getThreadChunkStart(threadIndex, numThreads, arrayLength);
+                uint_t chunkEnd = getThreadChunkEnd(threadIndex, numThreads, arrayLength);
+
+                for (uint_t index = chunkStart; index < chunkEnd; )
+                {
+                    uint_t blockIndex = index / sortedBlockSize;
+                    uint_t blockStart = blockIndex * sortedBlockSize;
+                    uint_t blockEnd = getEndIndex(blockStart, sortedBlockSize, arrayLength);
+                    uint_t mergeEnd = blockEnd < chunkEnd ? blockEnd : chunkEnd;
+
+                    mergeBlockPart<sortOrder, sortingKeyOnly>(
+                        h_keys, h_values, h_keysBuffer, h_valuesBuffer, arrayLength, sortedBlockSize, blockIndex,
+                        index - blockStart, mergeEnd - blockStart
+                    );
+                    index = mergeEnd;
+                }
+            });
+
+            // Exchanges key and value pointers with buffer
+            data_t *temp = h_keys;
+            h_keys = h_keysBuffer;
+            h_keysBuffer = temp;
+
+            if (!sortingKeyOnly)
+            {
+                temp = h_values;
+                h_values = h_valuesBuffer;
+                h_valuesBuffer = temp;
+            }
+        }
+    }
+
+    /*
+    Wrapper for multithreaded merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        uint_t numThreads = getNumThreadsUsed(_arrayLength, MIN_ELEMS_PER_THREAD_MULTITHREADED_KO);
+        bool isFirstPhaseInPlace = isFirstMergePhaseInPlace(_arrayLength, false);
+        _bytesCopySaved = isFirstPhaseInPlace ? (uint64_t)_arrayLength * sizeof(*_h_keys) : 0;
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortMultithreaded<ORDER_ASC, true>(_h_keys, NULL, _h_keysBuffer, NULL, numThreads, _arrayLength);
+        }
+        else
+        {
+            mergeSortMultithreaded<ORDER_DESC, true>(_h_keys, NULL, _h_keysBuffer, NULL, numThreads, _arrayLength);
+        }
+    }
+
+    /*
+    Wrapper for multithreaded merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        uint_t numThreads = getNumThreadsUsed(_arrayLength, MIN_ELEMS_PER_THREAD_MULTITHREADED_KV);
+        bool isFirstPhaseInPlace = isFirstMergePhaseInPlace(_arrayLength, false);
+        _bytesCopySaved = isFirstPhaseInPlace ? 2 * (uint64_t)_arrayLength * sizeof(*_h_keys) : 0;
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortMultithreaded<ORDER_ASC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, numThreads, _arrayLength
+            );
+        }
+        else
+        {
+            mergeSortMultithreaded<ORDER_DESC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, numThreads, _arrayLength
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Sets the number of host threads used for sort.
+    */
+    void setNumThreads(uint_t numThreads)
+    {
+        _numThreads = numThreads > 0 ? numThreads : 1;
+    }
+};
+
+#endif
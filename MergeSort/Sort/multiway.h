@@ -0,0 +1,395 @@
+#ifndef MERGE_SORT_MULTIWAY_H
+#define MERGE_SORT_MULTIWAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../constants.h"
+#include "sequential.h"
+
+
+/*
+Class for sequential multiway merge sort.
+Array is divided into runs, which fit into cache and are sorted with pairwise merge sort. After that k runs are
+merged at once with tournament (loser) tree, so the array is passed through memory only log_k(n) times instead of
+log_2(n) times. Number of merged runs (k) is selected so, that heads of runs fit into L1 cache of host, but is
+limited to MAX_WAYS_MULTIWAY, because every level of loser tree adds work for every merged element.
+Sort is stable.
+Merge of sorted chunks is also available as public method "mergeSortedChunks()".
+*/
+class MergeSortMultiway : public MergeSortSequential
+{
+protected:
+    std::string _sortName = "Merge sort multiway";
+
+    // Size of L1 cache of host in bytes
+    uint_t _cacheSizeL1 = getHostCacheSize(1) > 0 ? getHostCacheSize(1) : DEFAULT_CACHE_SIZE_L1_MULTIWAY;
+    // Number of runs merged at once by last sort
+    uint_t _numWays = 2;
+
+    /*
+    Selects the number of runs merged at once. Every run needs a cache line (64 bytes) of keys and values, which
+    are currently merged, and its node in loser tree. Half of L1 cache is reserved for run heads.
+    */
+    uint_t selectNumWays(bool sortingKeyOnly)
+    {
+        uint_t bytesPerWay = (sortingKeyOnly ? 1 : 2) * 64 + 3 * sizeof(uint_t) + sizeof(data_t);
+        uint_t numWays = 2;
+
+        while (numWays < MAX_WAYS_MULTIWAY && 2 * numWays * bytesPerWay <= _cacheSizeL1 / 2)
+        {
+            numWays *= 2;
+        }
+
+        return numWays;
+    }
+
+    /*
+    Returns the number of merge phases needed to sort the array with provided number of ways.
+    */
+    uint_t getNumMergePhases(uint_t arrayLength, uint_t numWays)
+    {
+        uint_t numPhases = 0;
+
+        for (uint64_t runLength = INITIAL_RUN_LENGTH_MULTIWAY; runLength < arrayLength; runLength *= numWays)
+        {
+            numPhases++;
+        }
+
+        return numPhases;
+    }
+
+    /*
+    Sorts runs of length INITIAL_RUN_LENGTH_MULTIWAY with pairwise merge sort. Runs fit into cache, so their merge
+    phases don't pass through memory. Sorted runs are output to primary or buffer array.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void sortInitialRuns(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t arrayLength,
+        bool isOutputToBuffer
+    )
+    {
+        for (uint_t runStart = 0; runStart < arrayLength; runStart += INITIAL_RUN_LENGTH_MULTIWAY)
+        {
+            uint_t runLength = getEndIndex(runStart, INITIAL_RUN_LENGTH_MULTIWAY, arrayLength) - runStart;
+
+            this->mergeSortSequential<sortOrder, sortingKeyOnly>(
+                h_keys + runStart, sortingKeyOnly ? NULL : h_values + runStart, h_keysBuffer + runStart,
+                sortingKeyOnly ? NULL : h_valuesBuffer + runStart, runLength, isOutputToBuffer
+            );
+        }
+    }
+
+    /*
+    Returns true, if key "key1" of run "run1" is merged before key "key2" of run "run2". In case of equal keys the
+    run with lower index is merged first, which keeps sort stable. Exhausted runs hold the last key in sort order
+    and index increased by number of leaves in loser tree, so they are merged last without additional branches.
+    */
+    template <order_t sortOrder>
+    bool isMergedBefore(data_t key1, uint_t run1, data_t key2, uint_t run2)
+    {
+        bool isKeyBefore = sortOrder == ORDER_ASC ? key1 < key2 : key1 > key2;
+        return isKeyBefore | ((key1 == key2) & (run1 < run2));
+    }
+
+    /*
+    Merges "numRuns" neighbouring sorted runs with loser tree and outputs the result to output arrays. Run "i" is
+    located in interval "[runStarts[i], runStarts[i + 1])". Merged runs are output to the same interval of output
+    arrays, in which they are located in input arrays.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void multiwayMerge(
+        data_t *h_keys, data_t *h_values, data_t *h_keysOutput, data_t *h_valuesOutput, uint_t *runStarts,
+        uint_t numRuns
+    )
+    {
+        uint_t mergeStart = runStarts[0];
+        uint_t mergeEnd = runStarts[numRuns];
+
+        if (numRuns == 1)
+        {
+            std::copy(h_keys + mergeStart, h_keys + mergeEnd, h_keysOutput + mergeStart);
+            if (!sortingKeyOnly)
+            {
+                std::copy(h_values + mergeStart, h_values + mergeEnd, h_valuesOutput + mergeStart);
+            }
+            return;
+        }
+
+        // Number of leaves in loser tree
+        uint_t numLeaves = nextPowerOf2(numRuns);
+        // Key of exhausted run
+        data_t keyExhausted = sortOrder == ORDER_ASC ? MAX_VAL : MIN_VAL;
+        // Current indexes and end indexes of runs. Leaves without run hold empty runs.
+        std::vector<uint_t> runHeads(numLeaves, 0);
+        std::vector<uint_t> runEnds(numLeaves, 0);
+        // Inner nodes of loser tree hold the run, which lost the match in node, and its key. Node 1 is the root.
+        std::vector<uint_t> losers(numLeaves);
+        std::vector<data_t> loserKeys(numLeaves);
+        std::vector<uint_t> winners(numLeaves);
+        std::vector<data_t> winnerKeys(numLeaves);
+
+        for (uint_t run = 0; run < numRuns; run++)
+        {
+            runHeads[run] = runStarts[run];
+            runEnds[run] = runStarts[run + 1];
+        }
+
+        // Builds the tree from leaves to the root
+        for (uint_t node = numLeaves - 1; node > 0; node--)
+        {
+            uint_t children[2] = {2 * node, 2 * node + 1};
+            uint_t runs[2];
+            data_t keys[2];
+
+            for (uint_t i = 0; i < 2; i++)
+            {
+                if (children[i] < numLeaves)
+                {
+                    runs[i] = winners[children[i]];
+                    keys[i] = winnerKeys[children[i]];
+                    continue;
+                }
+
+                uint_t run = children[i] - numLeaves;
+                bool isRunEmpty = runHeads[run] == runEnds[run];
+                runs[i] = isRunEmpty ? run + numLeaves : run;
+                keys[i] = isRunEmpty ? keyExhausted : h_keys[runHeads[run]];
+            }
+
+            bool isLeftWinner = isMergedBefore<sortOrder>(keys[0], runs[0], keys[1], runs[1]);
+            winners[node] = runs[!isLeftWinner];
+            winnerKeys[node] = keys[!isLeftWinner];
+            losers[node] = runs[isLeftWinner];
+            loserKeys[node] = keys[isLeftWinner];
+        }
+
+        uint_t winner = winners[1];
+
+        for (uint_t mergeIndex = mergeStart; mergeIndex < mergeEnd; mergeIndex++)
+        {
+            // Winner is never exhausted, until all elements are merged
+            uint_t run = winner;
+            uint_t index = runHeads[run]++;
+            data_t winnerKey;
+
+            h_keysOutput[mergeIndex] = h_keys[index];
+            if (!sortingKeyOnly)
+            {
+                h_valuesOutput[mergeIndex] = h_values[index];
+            }
+
+            if (index + 1 < runEnds[run])
+            {
+                winnerKey = h_keys[index + 1];
+            }
+            else
+            {
+                winnerKey = keyExhausted;
+                winner += numLeaves;
+            }
+
+            // Replays matches on the path from the leaf of run to the root. Winner of the match continues to the
+            // next node, loser stays in node.
+            for (uint_t node = (run + numLeaves) / 2; node > 0; node /= 2)
+            {
+                uint_t loser = losers[node];
+                data_t loserKey = loserKeys[node];
+                bool isLoserWinner = isMergedBefore<sortOrder>(loserKey, loser, winnerKey, winner);
+
+                // Exchange with masks, because compiler would otherwise generate unpredictable branches
+                uint_t runExchange = (loser ^ winner) & (0 - (uint_t)isLoserWinner);
+                data_t keyExchange = (loserKey ^ winnerKey) & (0 - (data_t)isLoserWinner);
+
+                losers[node] = loser ^ runExchange;
+                loserKeys[node] = loserKey ^ keyExchange;
+                winner ^= runExchange;
+                winnerKey ^= keyExchange;
+            }
+        }
+    }
+
+    /*
+    Sorts data sequentially with multiway merge sort. Returns the number of performed merge phases.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    uint_t mergeSortMultiway(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t arrayLength,
+        uint_t numWays
+    )
+    {
+        // Start indexes of runs merged at once and end index of the last run
+        std::vector<uint_t> runStarts(numWays + 1);
+        uint_t numPhases = 0;
+
+        // If number of merge phases is odd, initial runs are output to buffer, so the last merge phase outputs
+        // sorted array to primary array
+        bool isOddNumPhases = getNumMergePhases(arrayLength, numWays) % 2 == 1;
+        sortInitialRuns<sortOrder, sortingKeyOnly>(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, arrayLength, isOddNumPhases
+        );
+
+        if (isOddNumPhases)
+        {
+            data_t *temp = h_keys;
+            h_keys = h_keysBuffer;
+            h_keysBuffer = temp;
+
+            if (!sortingKeyOnly)
+            {
+                temp = h_values;
+                h_values = h_valuesBuffer;
+                h_valuesBuffer = temp;
+            }
+        }
+
+        for (uint64_t runLength = INITIAL_RUN_LENGTH_MULTIWAY; runLength < arrayLength; runLength *= numWays)
+        {
+            uint64_t groupLength = runLength * numWays;
+
+            // Merge of all groups of runs
+            for (uint64_t groupStart = 0; groupStart < arrayLength; groupStart += groupLength)
+            {
+                uint64_t groupEnd = groupStart + groupLength < arrayLength ? groupStart + groupLength : arrayLength;
+                uint_t numRuns = 0;
+
+                for (uint64_t runStart = groupStart; runStart < groupEnd; runStart += runLength)
+                {
+                    runStarts[numRuns++] = (uint_t)runStart;
+                }
+                runStarts[numRuns] = (uint_t)groupEnd;
+
+                multiwayMerge<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, runStarts.data(), numRuns
+                );
+            }
+
+            // Exchanges key and value pointers with buffer
+            data_t *temp = h_keys;
+            h_keys = h_keysBuffer;
+            h_keysBuffer = temp;
+
+            if (!sortingKeyOnly)
+            {
+                temp = h_values;
+                h_values = h_valuesBuffer;
+                h_valuesBuffer = temp;
+            }
+
+            numPhases++;
+        }
+
+        return numPhases;
+    }
+
+    /*
+    Wrapper for multiway merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        _numWays = selectNumWays(true);
+        bool isOddNumPhases = getNumMergePhases(_arrayLength, _numWays) % 2 == 1;
+        _bytesCopySaved = isOddNumPhases ? (uint64_t)_arrayLength * sizeof(*_h_keys) : 0;
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortMultiway<ORDER_ASC, true>(_h_keys, NULL, _h_keysBuffer, NULL, _arrayLength, _numWays);
+        }
+        else
+        {
+            mergeSortMultiway<ORDER_DESC, true>(_h_keys, NULL, _h_keysBuffer, NULL, _arrayLength, _numWays);
+        }
+    }
+
+    /*
+    Wrapper for multiway merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        _numWays = selectNumWays(false);
+        bool isOddNumPhases = getNumMergePhases(_arrayLength, _numWays) % 2 == 1;
+        _bytesCopySaved = isOddNumPhases ? 2 * (uint64_t)_arrayLength * sizeof(*_h_keys) : 0;
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortMultiway<ORDER_ASC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength, _numWays
+            );
+        }
+        else
+        {
+            mergeSortMultiway<ORDER_DESC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength, _numWays
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Returns the number of runs merged at once by last sort.
+    */
+    uint_t getNumWays()
+    {
+        return _numWays;
+    }
+
+    /*
+    Merges sorted chunks (for example sorted by other threads or devices) with loser tree in one pass. Chunk "i" is
+    located in interval "[chunkStarts[i], chunkStarts[i + 1])" and the last chunk ends at "arrayLength". Result is
+    output to provided output arrays. If values are NULL, only keys are merged. Merge is stable.
+    */
+    void mergeSortedChunks(
+        data_t *h_keys, data_t *h_values, data_t *h_keysOutput, data_t *h_valuesOutput, uint_t *chunkStarts,
+        uint_t numChunks, uint_t arrayLength, order_t sortOrder
+    )
+    {
+        if (numChunks == 0 || arrayLength == 0)
+        {
+            return;
+        }
+
+        std::vector<uint_t> runStarts(chunkStarts, chunkStarts + numChunks);
+        runStarts.push_back(arrayLength);
+
+        if (h_values == NULL)
+        {
+            if (sortOrder == ORDER_ASC)
+            {
+                multiwayMerge<ORDER_ASC, true>(h_keys, NULL, h_keysOutput, NULL, runStarts.data(), numChunks);
+            }
+            else
+            {
+                multiwayMerge<ORDER_DESC, true>(h_keys, NULL, h_keysOutput, NULL, runStarts.data(), numChunks);
+            }
+        }
+        else
+        {
+            if (sortOrder == ORDER_ASC)
+            {
+                multiwayMerge<ORDER_ASC, false>(
+                    h_keys, h_values, h_keysOutput, h_valuesOutput, runStarts.data(), numChunks
+                );
+            }
+            else
+            {
+                multiwayMerge<ORDER_DESC, false>(
+                    h_keys, h_values, h_keysOutput, h_valuesOutput, runStarts.data(), numChunks
+                );
+            }
+        }
+    }
+};
+
+#endif
@@ -8,10 +8,13 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../merge_simd.h"
 
 
 /*
 Class for sequential merge sort.
+If number of merge phases is odd, the first phase is performed in-place, so sorted array is always located in
+primary array and doesn't have to be copied from buffer after sort.
 */
 class MergeSortSequential : public SortSequential
 {
@@ -37,44 +40,52 @@ protected:
     }
 
     /*
-    In case if number of phases of merge sort is odd, then sorted array is located in buffer array. In that case
-    array has to be copied from buffer to primary array.
-    This could be also achieved with passing of pointers by reference, but this was easier to implement with
-    current class structure.
+    From provided array offset, size of array block and length of entire array returns end index of the block.
     */
-    virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    uint_t getEndIndex(uint_t offset, uint_t subBlockSize, uint_t arrayLength)
     {
-        SortSequential::memoryCopyAfterSort(h_keys, h_values, arrayLength);
-
-        uint_t numSortPhases = log2(nextPowerOf2(arrayLength));
-        if (numSortPhases % 2 == 0)
-        {
-            return;
-        }
-
-        std::copy(_h_keysBuffer, _h_keysBuffer + arrayLength, h_keys);
-        if (h_values != NULL)
-        {
-            std::copy(_h_valuesBuffer, _h_valuesBuffer + arrayLength, h_values);
-        }
+        uint_t endIndex = offset + subBlockSize;
+        return endIndex <= arrayLength ? endIndex : arrayLength;
     }
 
     /*
-    From provided array offset, size of array block and length of entire array returns end index of the block.
+    Returns true, if the first phase of merge sort has to be performed in-place, so that sorted array is output to
+    requested array (primary or buffer). Merge phases alternate between primary and buffer array, so after odd
+    number of phases sorted array would be located in the other array. This way copy after sort isn't needed.
     */
-    uint_t getEndIndex(uint_t offset, uint_t subBlockSize, uint_t arrayLength)
+    bool isFirstMergePhaseInPlace(uint_t arrayLength, bool isOutputToBuffer)
     {
-        uint_t endIndex = offset + subBlockSize;
-        return endIndex <= arrayLength ? endIndex : arrayLength;
+        uint_t numSortPhases = log2(nextPowerOf2(arrayLength));
+        return numSortPhases > 0 && (numSortPhases % 2 == 1) != isOutputToBuffer;
     }
 
     /*
-    Returns the output array. Implemented because sample sort class (which is derived from this class) requires
-    different function to determine output array than this class.
+    Performs the first phase of merge sort (merge of blocks of size 1) in-place. Elements are exchanged only if
+    they are out of order, which keeps sort stable.
     */
-    virtual data_t* getOutputMergeArray(data_t *arrayBuffer, data_t *arraySorted, bool isLastMergePhase)
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergePairsInPlace(data_t *h_keys, data_t *h_values, uint_t arrayLength)
     {
-        return arrayBuffer;
+        for (uint_t i = 0; i + 1 < arrayLength; i += 2)
+        {
+            data_t oddElement = h_keys[i];
+            data_t evenElement = h_keys[i + 1];
+
+            if (sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement)
+            {
+                continue;
+            }
+
+            h_keys[i] = evenElement;
+            h_keys[i + 1] = oddElement;
+
+            if (!sortingKeyOnly)
+            {
+                data_t temp = h_values[i];
+                h_values[i] = h_values[i + 1];
+                h_values[i + 1] = temp;
+            }
+        }
     }
 
     /*
@@ -82,15 +93,12 @@ protected:
     */
     template <order_t sortOrder, bool sortingKeyOnly>
     void mergeBlocks(
-        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
-        data_t *h_valuesSorted, uint_t arrayLength, uint_t sortedBlockSize, uint_t blockIndex, bool isLastMergePhase
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t arrayLength,
+        uint_t sortedBlockSize, uint_t blockIndex
     )
     {
         // Number of sub-blocks being merged
         uint_t subBlockSize = sortedBlockSize / 2;
-        // If it is last phase of merge sort, data is copied to result array
-        data_t *keysOutput = getOutputMergeArray(h_keysBuffer, h_keysSorted, isLastMergePhase);
-        data_t *valuesOutput = getOutputMergeArray(h_valuesBuffer, h_valuesSorted, isLastMergePhase);
 
         // Odd (left) block being merged
         uint_t oddIndex = blockIndex * sortedBlockSize;
@@ -99,10 +107,10 @@ protected:
         // If there is only odd block without even block, then only odd block is copied into buffer
         if (oddEnd == arrayLength)
         {
-            std::copy(h_keys + oddIndex, h_keys + oddEnd, keysOutput + oddIndex);
+            std::copy(h_keys + oddIndex, h_keys + oddEnd, h_keysBuffer + oddIndex);
             if (!sortingKeyOnly)
             {
-                std::copy(h_values + oddIndex, h_values + oddEnd, valuesOutput + oddIndex);
+                std::copy(h_values + oddIndex, h_values + oddEnd, h_valuesBuffer + oddIndex);
             }
             return;
         }
@@ -112,90 +120,95 @@ protected:
         uint_t evenEnd = getEndIndex(evenIndex, subBlockSize, arrayLength);
         uint_t mergeIndex = oddIndex;
 
-        // Merge of odd and even block
+        // Keys are merged with the widest SIMD merge kernel supported by host
+        if (sortingKeyOnly)
+        {
+            mergeKeys<sortOrder>(
+                h_keys + oddIndex, oddEnd - oddIndex, h_keys + evenIndex, evenEnd - evenIndex,
+                h_keysBuffer + mergeIndex
+            );
+            return;
+        }
+
+        // Merge of odd and even block. Element is selected without branch, because outcome of comparison is
+        // unpredictable.
         while (oddIndex < oddEnd && evenIndex < evenEnd)
         {
             data_t oddElement = h_keys[oddIndex];
             data_t evenElement = h_keys[evenIndex];
+            bool isOddMerged = sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement;
+            uint_t index = isOddMerged ? oddIndex : evenIndex;
 
-            if (sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement)
-            {
-                keysOutput[mergeIndex] = oddElement;
-                if (!sortingKeyOnly)
-                {
-                    valuesOutput[mergeIndex] = h_values[oddIndex];
-                }
+            h_keysBuffer[mergeIndex] = isOddMerged ? oddElement : evenElement;
+            h_valuesBuffer[mergeIndex] = h_values[index];
 
-                mergeIndex++;
-                oddIndex++;
-            }
-            else
-            {
-                keysOutput[mergeIndex] = evenElement;
-                if (!sortingKeyOnly)
-                {
-                    valuesOutput[mergeIndex] = h_values[evenIndex];
-                }
-
-                mergeIndex++;
-                evenIndex++;
-            }
+            mergeIndex++;
+            oddIndex += isOddMerged;
+            evenIndex += !isOddMerged;
         }
 
         // Block that wasn't merged entirely is copied into buffer array
         if (oddIndex == oddEnd)
         {
-            std::copy(h_keys + evenIndex, h_keys + evenEnd, keysOutput + mergeIndex);
+            std::copy(h_keys + evenIndex, h_keys + evenEnd, h_keysBuffer + mergeIndex);
             if (!sortingKeyOnly)
             {
-                std::copy(h_values + evenIndex, h_values + evenEnd, valuesOutput + mergeIndex);
+                std::copy(h_values + evenIndex, h_values + evenEnd, h_valuesBuffer + mergeIndex);
             }
         }
         else
         {
-            std::copy(h_keys + oddIndex, h_keys + oddEnd, keysOutput + mergeIndex);
+            std::copy(h_keys + oddIndex, h_keys + oddEnd, h_keysBuffer + mergeIndex);
             if (!sortingKeyOnly)
             {
-                std::copy(h_values + oddIndex, h_values + oddEnd, valuesOutput + mergeIndex);
+                std::copy(h_values + oddIndex, h_values + oddEnd, h_valuesBuffer + mergeIndex);
             }
         }
     }
 
     /*
-    Sorts data sequentially with merge sort.
-    Arrays for sorted keys and values are needed in sample sort, which is derived from this class.
+    Sorts data sequentially with merge sort. Sorted array is output to primary array or to buffer array (needed in
+    sample sort, which is derived from this class).
     */
     template <order_t sortOrder, bool sortingKeyOnly>
     void mergeSortSequential(
-        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
-        data_t *h_valuesSorted, uint_t arrayLength
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t arrayLength,
+        bool isOutputToBuffer
     )
     {
         if (arrayLength == 1)
         {
-            h_keysSorted[0] = h_keys[0];
-            if (!sortingKeyOnly)
+            if (isOutputToBuffer)
             {
-                h_valuesSorted[0] = h_values[0];
+                h_keysBuffer[0] = h_keys[0];
+                if (!sortingKeyOnly)
+                {
+                    h_valuesBuffer[0] = h_values[0];
+                }
             }
             return;
         }
 
         uint_t arrayLenPower2 = nextPowerOf2(arrayLength);
+        uint_t sortedBlockSize = 2;
+
+        if (isFirstMergePhaseInPlace(arrayLength, isOutputToBuffer))
+        {
+            mergePairsInPlace<sortOrder, sortingKeyOnly>(h_keys, h_values, arrayLength);
+            sortedBlockSize *= 2;
+        }
 
         // Log(arrayLength) phases of merge sort
-        for (uint_t sortedBlockSize = 2; sortedBlockSize <= arrayLenPower2; sortedBlockSize *= 2)
+        for (; sortedBlockSize <= arrayLenPower2; sortedBlockSize *= 2)
         {
             // Number of merged blocks that will be created in this iteration
             uint_t numBlocks = (arrayLength - 1) / sortedBlockSize + 1;
-            bool isLastMergePhase = numBlocks == 1;
 
             // Merge of all blocks
             for (uint_t blockIndex = 0; blockIndex < numBlocks; blockIndex++)
             {
                 mergeBlocks<sortOrder, sortingKeyOnly>(
-                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, arrayLength,
-                    sortedBlockSize, blockIndex, isLastMergePhase
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, arrayLength, sortedBlockSize, blockIndex
                 );
             }
 
@@ -219,13 +232,16 @@ protected:
     */
     void sortKeyOnly()
     {
+        bool isFirstPhaseInPlace = isFirstMergePhaseInPlace(_arrayLength, false);
+        _bytesCopySaved = isFirstPhaseInPlace ? (uint64_t)_arrayLength * sizeof(*_h_keys) : 0;
+
         if (_sortOrder == ORDER_ASC)
         {
-            mergeSortSequential<ORDER_ASC, true>(_h_keys, NULL, _h_keysBuffer, NULL, NULL, NULL, _arrayLength);
+            mergeSortSequential<ORDER_ASC, true>(_h_keys, NULL, _h_keysBuffer, NULL, _arrayLength, false);
         }
         else
         {
-            mergeSortSequential<ORDER_DESC, true>(_h_keys, NULL, _h_keysBuffer, NULL, NULL, NULL, _arrayLength);
+            mergeSortSequential<ORDER_DESC, true>(_h_keys, NULL, _h_keysBuffer, NULL, _arrayLength, false);
         }
     }
 
@@ -235,16 +251,19 @@ protected:
     */
     void sortKeyValue()
     {
+        bool isFirstPhaseInPlace = isFirstMergePhaseInPlace(_arrayLength, false);
+        _bytesCopySaved = isFirstPhaseInPlace ? 2 * (uint64_t)_arrayLength * sizeof(*_h_keys) : 0;
+
         if (_sortOrder == ORDER_ASC)
         {
             mergeSortSequential<ORDER_ASC, false>(
-                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, NULL, NULL, _arrayLength
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength, false
             );
         }
         else
         {
             mergeSortSequential<ORDER_DESC, false>(
-                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, NULL, NULL, _arrayLength
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength, false
             );
         }
     }
@@ -0,0 +1,586 @@
+#ifndef MERGE_SORT_SEQUENTIAL_IN_PLACE_H
+#define MERGE_SORT_SEQUENTIAL_IN_PLACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../merge_simd.h"
+#include "../constants.h"
+
+
+/*
+Class for sequential stable merge sort with O(sqrt(n)) extra memory.
+Short runs are sorted with insertion sort and merged bottom-up. If the shorter of merged runs fits into buffer of
+length sqrt(n), it is merged through buffer. Otherwise runs are merged with block merge in linear time: runs are
+split into blocks of buffer length, blocks are ordered by their first element and every block is then merged only
+with the not yet merged fragment of previous block. Blocks of left run are placed before blocks of right run with
+equal first element, so sort is stable for key-value pairs.
+Used for arrays, for which buffers of array length can't be allocated.
+*/
+class MergeSortSequentialInPlace : public SortSequential
+{
+protected:
+    std::string _sortName = "Merge sort sequential in-place";
+
+    // Buffer for keys
+    data_t *_h_keysBuffer = NULL;
+    // Buffer for values
+    data_t *_h_valuesBuffer = NULL;
+    // Length of buffers
+    uint_t _bufferLength = 0;
+    // Order of blocks in block merge
+    uint_t *_h_blockOrder = NULL;
+
+    /*
+    Returns the length of buffer used for merges of array with provided length.
+    */
+    uint_t getBufferLength(uint_t arrayLength)
+    {
+        uint_t bufferLength = (uint_t)sqrt((double)arrayLength) + 1;
+        return bufferLength > MIN_BUFFER_LENGTH_IN_PLACE ? bufferLength : MIN_BUFFER_LENGTH_IN_PLACE;
+    }
+
+    /*
+    Returns the length of blocks in block merge, which is the greatest power of 2 not exceeding buffer length.
+    Runs have power of 2 length, so only the last run in every merge phase has partial block.
+    */
+    uint_t getBlockLength(uint_t bufferLength)
+    {
+        uint_t blockLength = 1;
+        while (2 * blockLength <= bufferLength)
+        {
+            blockLength *= 2;
+        }
+        return blockLength;
+    }
+
+    /*
+    Method for allocating memory needed both for key only and key-value sort.
+    */
+    virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
+
+        // Memory has to be released, if sort was already performed on shorter array
+        free(_h_keysBuffer);
+        free(_h_valuesBuffer);
+        free(_h_blockOrder);
+
+        _bufferLength = getBufferLength(arrayLength);
+        _h_keysBuffer = (data_t*)malloc(_bufferLength * sizeof(*_h_keysBuffer));
+        checkMallocError(_h_keysBuffer);
+        _h_valuesBuffer = (data_t*)malloc(_bufferLength * sizeof(*_h_valuesBuffer));
+        checkMallocError(_h_valuesBuffer);
+
+        uint_t maxNumBlocks = arrayLength / getBlockLength(_bufferLength) + 1;
+        _h_blockOrder = (uint_t*)malloc(maxNumBlocks * sizeof(*_h_blockOrder));
+        checkMallocError(_h_blockOrder);
+    }
+
+    /*
+    Returns true, if element "elem1" can be located before element "elem2" in sorted array.
+    */
+    template <order_t sortOrder>
+    bool isOrdered(data_t elem1, data_t elem2)
+    {
+        return sortOrder == ORDER_ASC ? elem1 <= elem2 : elem1 >= elem2;
+    }
+
+    /*
+    Sorts runs of length INSERTION_SORT_LENGTH_IN_PLACE with insertion sort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void insertionSortRuns(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        for (uint_t runStart = 0; runStart < arrayLength; runStart += INSERTION_SORT_LENGTH_IN_PLACE)
+        {
+            uint_t runEnd = std::min(runStart + INSERTION_SORT_LENGTH_IN_PLACE, arrayLength);
+
+            for (uint_t i = runStart + 1; i < runEnd; i++)
+            {
+                data_t key = h_keys[i];
+                data_t value = sortingKeyOnly ? 0 : h_values[i];
+                uint_t j = i;
+
+                for (; j > runStart && !isOrdered<sortOrder>(h_keys[j - 1], key); j--)
+                {
+                    h_keys[j] = h_keys[j - 1];
+                    if (!sortingKeyOnly)
+                    {
+                        h_values[j] = h_values[j - 1];
+                    }
+                }
+
+                h_keys[j] = key;
+                if (!sortingKeyOnly)
+                {
+                    h_values[j] = value;
+                }
+            }
+        }
+    }
+
+    /*
+    Merges runs "[runStart, runMiddle)" and "[runMiddle, runEnd)" through buffer. The shorter run is copied to
+    buffer and merged with the other run back into array (forward for left run, backward for right run).
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeBuffered(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t runStart,
+        uint_t runMiddle, uint_t runEnd
+    )
+    {
+        uint_t leftLength = runMiddle - runStart;
+        uint_t rightLength = runEnd - runMiddle;
+
+        if (leftLength <= rightLength)
+        {
+            std::copy(h_keys + runStart, h_keys + runMiddle, h_keysBuffer);
+            if (!sortingKeyOnly)
+            {
+                std::copy(h_values + runStart, h_values + runMiddle, h_valuesBuffer);
+            }
+
+            // Merge kernel writes keys only to positions of keys, which were already read, so keys can be merged
+            // with SIMD kernel directly into the right run
+            if (sortingKeyOnly)
+            {
+                mergeKeys<sortOrder>(h_keysBuffer, leftLength, h_keys + runMiddle, rightLength, h_keys + runStart);
+                return;
+            }
+
+            uint_t leftIndex = 0, rightIndex = runMiddle, mergeIndex = runStart;
+
+            // When left run is merged, remaining elements of right run are already in place
+            while (leftIndex < leftLength)
+            {
+                bool isLeftMerged = rightIndex == runEnd || isOrdered<sortOrder>(
+                    h_keysBuffer[leftIndex], h_keys[rightIndex]
+                );
+
+                h_keys[mergeIndex] = isLeftMerged ? h_keysBuffer[leftIndex] : h_keys[rightIndex];
+                if (!sortingKeyOnly)
+                {
+                    h_values[mergeIndex] = isLeftMerged ? h_valuesBuffer[leftIndex] : h_values[rightIndex];
+                }
+
+                leftIndex += isLeftMerged;
+                rightIndex += !isLeftMerged;
+                mergeIndex++;
+            }
+        }
+        else
+        {
+            std::copy(h_keys + runMiddle, h_keys + runEnd, h_keysBuffer);
+            if (!sortingKeyOnly)
+            {
+                std::copy(h_values + runMiddle, h_values + runEnd, h_valuesBuffer);
+            }
+
+            // Indexes are incremented by one, so they don't underflow
+            uint_t leftIndex = runMiddle, rightIndex = rightLength, mergeIndex = runEnd;
+
+            // When right run is merged, remaining elements of left run are already in place
+            while (rightIndex > 0)
+            {
+                bool isRightMerged = leftIndex == runStart || isOrdered<sortOrder>(
+                    h_keys[leftIndex - 1], h_keysBuffer[rightIndex - 1]
+                );
+
+                h_keys[mergeIndex - 1] = isRightMerged ? h_keysBuffer[rightIndex - 1] : h_keys[leftIndex - 1];
+                if (!sortingKeyOnly)
+                {
+                    h_values[mergeIndex - 1] = isRightMerged ? h_valuesBuffer[rightIndex - 1] : h_values[leftIndex - 1];
+                }
+
+                rightIndex -= isRightMerged;
+                leftIndex -= !isRightMerged;
+                mergeIndex--;
+            }
+        }
+    }
+
+    /*
+    Orders blocks of runs "[blocksStart, blocksMiddle)" and "[blocksMiddle, blocksEnd)" by their first element.
+    Blocks inside every run are already ordered, so first elements of both runs are merged. Block of left run is
+    placed before block of right run with equal first element. For every position the index of block, which has to
+    be moved there, is saved to block order array.
+    */
+    template <order_t sortOrder>
+    void orderBlocks(
+        data_t *h_keys, uint_t *h_blockOrder, uint_t blockLength, uint_t blocksStart, uint_t blocksMiddle,
+        uint_t blocksEnd
+    )
+    {
+        uint_t numBlocksLeft = (blocksMiddle - blocksStart) / blockLength;
+        uint_t numBlocks = (blocksEnd - blocksStart) / blockLength;
+        uint_t leftBlock = 0, rightBlock = numBlocksLeft;
+
+        for (uint_t blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+        {
+            bool isLeftBlock = rightBlock == numBlocks || (leftBlock < numBlocksLeft && isOrdered<sortOrder>(
+                h_keys[blocksStart + leftBlock * blockLength], h_keys[blocksStart + rightBlock * blockLength]
+            ));
+
+            h_blockOrder[blockIndex] = isLeftBlock ? leftBlock : rightBlock;
+            leftBlock += isLeftBlock;
+            rightBlock += !isLeftBlock;
+        }
+    }
+
+    /*
+    Moves blocks to positions saved in block order array. Permutation is performed by following its cycles, so
+    every block is moved only once and only one block per cycle is copied to buffer. Moved blocks are tagged with
+    BLOCK_MOVED_IN_PLACE in block order array, but index of block is preserved, because it determines from which
+    run the block originates.
+    */
+    template <bool sortingKeyOnly>
+    void permuteBlocks(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *h_blockOrder,
+        uint_t blockLength, uint_t blocksStart, uint_t numBlocks
+    )
+    {
+        for (uint_t cycleStart = 0; cycleStart < numBlocks; cycleStart++)
+        {
+            if (h_blockOrder[cycleStart] & BLOCK_MOVED_IN_PLACE)
+            {
+                continue;
+            }
+
+            data_t *keysCycleStart = h_keys + blocksStart + cycleStart * blockLength;
+            std::copy(keysCycleStart, keysCycleStart + blockLength, h_keysBuffer);
+            if (!sortingKeyOnly)
+            {
+                data_t *valuesCycleStart = h_values + blocksStart + cycleStart * blockLength;
+                std::copy(valuesCycleStart, valuesCycleStart + blockLength, h_valuesBuffer);
+            }
+
+            uint_t blockIndex = cycleStart;
+            uint_t sourceIndex = h_blockOrder[blockIndex];
+
+            while (sourceIndex != cycleStart)
+            {
+                uint_t destination = blocksStart + blockIndex * blockLength;
+                uint_t source = blocksStart + sourceIndex * blockLength;
+
+                std::copy(h_keys + source, h_keys + source + blockLength, h_keys + destination);
+                if (!sortingKeyOnly)
+                {
+                    std::copy(h_values + source, h_values + source + blockLength, h_values + destination);
+                }
+
+                h_blockOrder[blockIndex] |= BLOCK_MOVED_IN_PLACE;
+                blockIndex = sourceIndex;
+                sourceIndex = h_blockOrder[blockIndex];
+            }
+
+            uint_t destination = blocksStart + blockIndex * blockLength;
+            std::copy(h_keysBuffer, h_keysBuffer + blockLength, h_keys + destination);
+            if (!sortingKeyOnly)
+            {
+                std::copy(h_valuesBuffer, h_valuesBuffer + blockLength, h_values + destination);
+            }
+            h_blockOrder[blockIndex] |= BLOCK_MOVED_IN_PLACE;
+        }
+    }
+
+    /*
+    Returns the number of elements in "[0, length)", which are merged before the key. If elements are equal, the
+    key is merged first if flag "isKeyFirst" is set.
+    */
+    template <order_t sortOrder>
+    uint_t getNumMergedBefore(data_t *h_keys, uint_t length, data_t key, bool isKeyFirst)
+    {
+        uint_t indexStart = 0, indexEnd = length;
+
+        while (indexStart < indexEnd)
+        {
+            uint_t index = indexStart + (indexEnd - indexStart) / 2;
+            bool isMergedBefore = isKeyFirst ? !isOrdered<sortOrder>(key, h_keys[index]) : isOrdered<sortOrder>(
+                h_keys[index], key
+            );
+
+            if (isMergedBefore)
+            {
+                indexStart = index + 1;
+            }
+            else
+            {
+                indexEnd = index;
+            }
+        }
+
+        return indexStart;
+    }
+
+    /*
+    Merges not yet merged fragment "[fragmentStart, blockStart)" with the following block "[blockStart, blockEnd)",
+    which originates from the other run. Fragment is copied to buffer and merged forward until fragment or block is
+    merged. Remaining elements are placed at the end of block and become the new fragment. Returns the start of new
+    fragment and sets, whether it originates from left run. Elements of left run are merged first if keys are equal.
+    When sorting keys only, merged lengths are found with binary search and merged with SIMD kernel.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    uint_t mergeFragment(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t fragmentStart,
+        uint_t blockStart, uint_t blockEnd, bool &isFragmentLeft
+    )
+    {
+        uint_t fragmentLength = blockStart - fragmentStart;
+
+        std::copy(h_keys + fragmentStart, h_keys + blockStart, h_keysBuffer);
+        if (!sortingKeyOnly)
+        {
+            std::copy(h_values + fragmentStart, h_values + blockStart, h_valuesBuffer);
+        }
+
+        uint_t fragmentIndex = 0, blockIndex = blockStart, mergeIndex = fragmentStart;
+
+        if (sortingKeyOnly)
+        {
+            data_t fragmentLast = h_keysBuffer[fragmentLength - 1];
+            data_t blockLast = h_keys[blockEnd - 1];
+            bool isFragmentMergedFirst = isFragmentLeft ? isOrdered<sortOrder>(fragmentLast, blockLast) :
+                !isOrdered<sortOrder>(blockLast, fragmentLast);
+
+            if (isFragmentMergedFirst)
+            {
+                fragmentIndex = fragmentLength;
+                blockIndex += getNumMergedBefore<sortOrder>(
+                    h_keys + blockStart, blockEnd - blockStart, fragmentLast, isFragmentLeft
+                );
+            }
+            else
+            {
+                fragmentIndex = getNumMergedBefore<sortOrder>(h_keysBuffer, fragmentLength, blockLast, !isFragmentLeft);
+                blockIndex = blockEnd;
+            }
+
+            mergeKeys<sortOrder>(
+                h_keysBuffer, fragmentIndex, h_keys + blockStart, blockIndex - blockStart, h_keys + fragmentStart
+            );
+            mergeIndex += fragmentIndex + blockIndex - blockStart;
+        }
+
+        while (fragmentIndex < fragmentLength && blockIndex < blockEnd)
+        {
+            bool isFragmentMerged = isFragmentLeft ?
+                isOrdered<sortOrder>(h_keysBuffer[fragmentIndex], h_keys[blockIndex]) :
+                !isOrdered<sortOrder>(h_keys[blockIndex], h_keysBuffer[fragmentIndex]);
+
+            h_keys[mergeIndex] = isFragmentMerged ? h_keysBuffer[fragmentIndex] : h_keys[blockIndex];
+            if (!sortingKeyOnly)
+            {
+                h_values[mergeIndex] = isFragmentMerged ? h_valuesBuffer[fragmentIndex] : h_values[blockIndex];
+            }
+
+            fragmentIndex += isFragmentMerged;
+            blockIndex += !isFragmentMerged;
+            mergeIndex++;
+        }
+
+        // Remaining elements of block are already in place
+        if (fragmentIndex == fragmentLength)
+        {
+            isFragmentLeft = !isFragmentLeft;
+            return blockIndex;
+        }
+
+        std::copy(h_keysBuffer + fragmentIndex, h_keysBuffer + fragmentLength, h_keys + mergeIndex);
+        if (!sortingKeyOnly)
+        {
+            std::copy(h_valuesBuffer + fragmentIndex, h_valuesBuffer + fragmentLength, h_values + mergeIndex);
+        }
+
+        return mergeIndex;
+    }
+
+    /*
+    Merges runs "[runStart, runMiddle)" and "[runMiddle, runEnd)" with block merge in linear time.
+    Left run is split into partial block at its start and full blocks, right run is split into full blocks and
+    partial block at its end. Full blocks are ordered by their first element. After that every element is located
+    either in the not yet merged fragment of previous block or in the current block, so blocks are merged one after
+    another with the fragment of previous block. Partial block of left run is the first fragment, because it contains
+    the smallest elements of left run. Partial block of right run is merged through buffer at the end.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeBlocks(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *h_blockOrder,
+        uint_t blockLength, uint_t runStart, uint_t runMiddle, uint_t runEnd
+    )
+    {
+        uint_t blocksStart = runStart + (runMiddle - runStart) % blockLength;
+        uint_t blocksEnd = runEnd - (runEnd - runMiddle) % blockLength;
+        uint_t numBlocksLeft = (runMiddle - blocksStart) / blockLength;
+        uint_t numBlocks = (blocksEnd - blocksStart) / blockLength;
+
+        orderBlocks<sortOrder>(h_keys, h_blockOrder, blockLength, blocksStart, runMiddle, blocksEnd);
+        permuteBlocks<sortingKeyOnly>(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_blockOrder, blockLength, blocksStart, numBlocks
+        );
+
+        uint_t fragmentStart = runStart;
+        bool isFragmentLeft = true;
+
+        for (uint_t blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+        {
+            uint_t blockStart = blocksStart + blockIndex * blockLength;
+            uint_t blockEnd = blockStart + blockLength;
+            bool isBlockLeft = (h_blockOrder[blockIndex] & ~BLOCK_MOVED_IN_PLACE) < numBlocksLeft;
+
+            // If block originates from the same run as fragment, or if fragment and block are already ordered,
+            // fragment is merged
+            if (fragmentStart == blockStart || isBlockLeft == isFragmentLeft || (isFragmentLeft ?
+                isOrdered<sortOrder>(h_keys[blockStart - 1], h_keys[blockStart]) :
+                !isOrdered<sortOrder>(h_keys[blockStart], h_keys[blockStart - 1])))
+            {
+                fragmentStart = blockStart;
+                isFragmentLeft = isBlockLeft;
+            }
+            else
+            {
+                fragmentStart = mergeFragment<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, fragmentStart, blockStart, blockEnd,
+                    isFragmentLeft
+                );
+            }
+        }
+
+        if (blocksEnd < runEnd && !isOrdered<sortOrder>(h_keys[blocksEnd - 1], h_keys[blocksEnd]))
+        {
+            mergeBuffered<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, runStart, blocksEnd, runEnd
+            );
+        }
+    }
+
+    /*
+    Merges runs "[runStart, runMiddle)" and "[runMiddle, runEnd)". If shorter run fits into buffer, runs are merged
+    through buffer, otherwise with block merge.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeInPlace(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *h_blockOrder,
+        uint_t bufferLength, uint_t blockLength, uint_t runStart, uint_t runMiddle, uint_t runEnd
+    )
+    {
+        // Runs are already merged
+        if (isOrdered<sortOrder>(h_keys[runMiddle - 1], h_keys[runMiddle]))
+        {
+            return;
+        }
+
+        if (std::min(runMiddle - runStart, runEnd - runMiddle) <= bufferLength)
+        {
+            mergeBuffered<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, runStart, runMiddle, runEnd
+            );
+        }
+        else
+        {
+            mergeBlocks<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_blockOrder, blockLength, runStart, runMiddle,
+                runEnd
+            );
+        }
+    }
+
+    /*
+    Sorts data sequentially with in-place merge sort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeSortInPlace(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *h_blockOrder,
+        uint_t bufferLength, uint_t arrayLength
+    )
+    {
+        uint_t blockLength = getBlockLength(bufferLength);
+        insertionSortRuns<sortOrder, sortingKeyOnly>(h_keys, h_values, arrayLength);
+
+        for (uint64_t runLength = INSERTION_SORT_LENGTH_IN_PLACE; runLength < arrayLength; runLength *= 2)
+        {
+            for (uint64_t runStart = 0; runStart + runLength < arrayLength; runStart += 2 * runLength)
+            {
+                uint64_t runEnd = std::min(runStart + 2 * runLength, (uint64_t)arrayLength);
+
+                mergeInPlace<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_blockOrder, bufferLength, blockLength,
+                    (uint_t)runStart, (uint_t)(runStart + runLength), (uint_t)runEnd
+                );
+            }
+        }
+    }
+
+    /*
+    Wrapper for in-place merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortInPlace<ORDER_ASC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_blockOrder, _bufferLength, _arrayLength
+            );
+        }
+        else
+        {
+            mergeSortInPlace<ORDER_DESC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_blockOrder, _bufferLength, _arrayLength
+            );
+        }
+    }
+
+    /*
+    Wrapper for in-place merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortInPlace<ORDER_ASC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_blockOrder, _bufferLength, _arrayLength
+            );
+        }
+        else
+        {
+            mergeSortInPlace<ORDER_DESC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_blockOrder, _bufferLength, _arrayLength
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Method for destroying memory needed for sort. For sort testing purposes this method is public.
+    */
+    void memoryDestroy()
+    {
+        if (_arrayLength == 0)
+        {
+            return;
+        }
+
+        SortSequential::memoryDestroy();
+
+        free(_h_keysBuffer);
+        free(_h_valuesBuffer);
+        free(_h_blockOrder);
+        _h_keysBuffer = NULL;
+        _h_valuesBuffer = NULL;
+        _h_blockOrder = NULL;
+    }
+};
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef MERGE_SORT_SEQUENTIAL_NATURAL_H
+#define MERGE_SORT_SEQUENTIAL_NATURAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../constants.h"
+#include "sequential.h"
+
+
+/*
+Class for sequential natural merge sort, which is adaptive to presorted input.
+Array is scanned for runs, which are already sorted (or sorted in reverse order - these are reversed). Short runs
+are extended to minimum length with insertion sort. Runs are merged with policy of powersort, which keeps merges
+balanced. Sorted and reverse sorted arrays are sorted in O(n). Sort is stable.
+*/
+class MergeSortSequentialNatural : public MergeSortSequential
+{
+protected:
+    std::string _sortName = "Merge sort sequential natural";
+
+    /*
+    Returns true, if element "elem1" can be located before element "elem2" in sorted array.
+    */
+    template <order_t sortOrder>
+    bool isOrdered(data_t elem1, data_t elem2)
+    {
+        return sortOrder == ORDER_ASC ? elem1 <= elem2 : elem1 >= elem2;
+    }
+
+    /*
+    Exchanges elements on provided indexes.
+    */
+    template <bool sortingKeyOnly>
+    void exchangeElements(data_t *h_keys, data_t *h_values, uint_t index1, uint_t index2)
+    {
+        data_t temp = h_keys[index1];
+        h_keys[index1] = h_keys[index2];
+        h_keys[index2] = temp;
+
+        if (!sortingKeyOnly)
+        {
+            temp = h_values[index1];
+            h_values[index1] = h_values[index2];
+            h_values[index2] = temp;
+        }
+    }
+
+    /*
+    Sorts elements from "runEnd" to "arrayEnd" into run "[runStart, runEnd)" with binary insertion sort. Equal
+    elements are inserted after existing elements, which keeps sort stable.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void insertionSort(data_t *h_keys, data_t *h_values, uint_t runStart, uint_t runEnd, uint_t arrayEnd)
+    {
+        for (; runEnd < arrayEnd; runEnd++)
+        {
+            data_t key = h_keys[runEnd];
+            data_t value = sortingKeyOnly ? 0 : h_values[runEnd];
+            uint_t indexStart = runStart;
+            uint_t indexEnd = runEnd;
+
+            // Finds the index after the last element, which can be located before inserted element
+            while (indexStart < indexEnd)
+            {
+                uint_t index = (indexStart + indexEnd) / 2;
+
+                if (isOrdered<sortOrder>(h_keys[index], key))
+                {
+                    indexStart = index + 1;
+                }
+                else
+                {
+                    indexEnd = index;
+                }
+            }
+
+            std::copy_backward(h_keys + indexStart, h_keys + runEnd, h_keys + runEnd + 1);
+            h_keys[indexStart] = key;
+            if (!sortingKeyOnly)
+            {
+                std::copy_backward(h_values + indexStart, h_values + runEnd, h_values + runEnd + 1);
+                h_values[indexStart] = value;
+            }
+        }
+    }
+
+    /*
+    Reverses elements in interval "[indexStart, indexEnd)".
+    */
+    template <bool sortingKeyOnly>
+    void reverseElements(data_t *h_keys, data_t *h_values, uint_t indexStart, uint_t indexEnd)
+    {
+        for (uint_t i = indexStart, j = indexEnd - 1; i < j; i++, j--)
+        {
+            exchangeElements<sortingKeyOnly>(h_keys, h_values, i, j);
+        }
+    }
+
+    /*
+    Finds the run, which starts at provided index, and returns its end index. Runs in reverse order are reversed.
+    After that groups of equal elements in them are reversed again, which keeps sort stable. Runs shorter than
+    minimum run length are extended with insertion sort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    uint_t getRunEnd(data_t *h_keys, data_t *h_values, uint_t runStart, uint_t arrayLength)
+    {
+        uint_t runEnd = runStart + 1;
+
+        if (runEnd < arrayLength && !isOrdered<sortOrder>(h_keys[runStart], h_keys[runEnd]))
+        {
+            while (runEnd < arrayLength && isOrdered<sortOrder>(h_keys[runEnd], h_keys[runEnd - 1]))
+            {
+                runEnd++;
+            }
+
+            reverseElements<sortingKeyOnly>(h_keys, h_values, runStart, runEnd);
+
+            // Restores the order of equal elements
+            for (uint_t groupStart = runStart, i = runStart + 1; i <= runEnd; i++)
+            {
+                if (i == runEnd || h_keys[i] != h_keys[groupStart])
+                {
+                    reverseElements<sortingKeyOnly>(h_keys, h_values, groupStart, i);
+                    groupStart = i;
+                }
+            }
+        }
+        else
+        {
+            while (runEnd < arrayLength && isOrdered<sortOrder>(h_keys[runEnd - 1], h_keys[runEnd]))
+            {
+                runEnd++;
+            }
+        }
+
+        uint_t minRunEnd = getEndIndex(runStart, MIN_RUN_LENGTH_NATURAL, arrayLength);
+        if (runEnd < minRunEnd)
+        {
+            insertionSort<sortOrder, sortingKeyOnly>(h_keys, h_values, runStart, runEnd, minRunEnd);
+            runEnd = minRunEnd;
+        }
+
+        return runEnd;
+    }
+
+    /*
+    Returns the power of node between two neighbouring runs "[runStart1, runStart2)" and "[runStart2, runEnd2)"
+    as defined by powersort. It is the depth of node in perfectly balanced merge tree over the whole array.
+    */
+    uint_t getNodePower(uint_t runStart1, uint_t runStart2, uint_t runEnd2, uint_t arrayLength)
+    {
+        // Midpoints of runs multiplied by 2
+        uint64_t midpoint1 = (uint64_t)runStart1 + runStart2;
+        uint64_t midpoint2 = (uint64_t)runStart2 + runEnd2;
+        uint_t power = 0;
+
+        // Compares binary digits of relative midpoints "midpoint / (2 * arrayLength)"
+        while (true)
+        {
+            power++;
+            bool bit1 = midpoint1 >= arrayLength;
+            bool bit2 = midpoint2 >= arrayLength;
+
+            if (bit1 != bit2)
+            {
+                return power;
+            }
+
+            if (bit1)
+            {
+                midpoint1 -= arrayLength;
+                midpoint2 -= arrayLength;
+            }
+            midpoint1 *= 2;
+            midpoint2 *= 2;
+        }
+    }
+
+    /*
+    Merges neighbouring runs "[runStart, runMiddle)" and "[runMiddle, runEnd)" in primary array. Elements of left
+    run, which are already in place, are skipped. Remaining elements of left run are copied to buffer and merged
+    with right run back into primary array.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeRuns(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t runStart,
+        uint_t runMiddle, uint_t runEnd
+    )
+    {
+        // Runs are already merged
+        if (isOrdered<sortOrder>(h_keys[runMiddle - 1], h_keys[runMiddle]))
+        {
+            return;
+        }
+
+        // Skips elements of left run, which are located before the first element of right run
+        data_t firstRight = h_keys[runMiddle];
+        uint_t indexEnd = runMiddle;
+        while (runStart < indexEnd)
+        {
+            uint_t index = (runStart + indexEnd) / 2;
+
+            if (isOrdered<sortOrder>(h_keys[index], firstRight))
+            {
+                runStart = index + 1;
+            }
+            else
+            {
+                indexEnd = index;
+            }
+        }
+
+        uint_t leftLength = runMiddle - runStart;
+        std::copy(h_keys + runStart, h_keys + runMiddle, h_keysBuffer);
+        if (!sortingKeyOnly)
+        {
+            std::copy(h_values + runStart, h_values + runMiddle, h_valuesBuffer);
+        }
+
+        uint_t leftIndex = 0, rightIndex = runMiddle, mergeIndex = runStart;
+
+        // When left run is merged, remaining elements of right run are already in place
+        while (leftIndex < leftLength)
+        {
+            if (rightIndex == runEnd || isOrdered<sortOrder>(h_keysBuffer[leftIndex], h_keys[rightIndex]))
+            {
+                h_keys[mergeIndex] = h_keysBuffer[leftIndex];
+                if (!sortingKeyOnly)
+                {
+                    h_values[mergeIndex] = h_valuesBuffer[leftIndex];
+                }
+                leftIndex++;
+            }
+            else
+            {
+                h_keys[mergeIndex] = h_keys[rightIndex];
+                if (!sortingKeyOnly)
+                {
+                    h_values[mergeIndex] = h_values[rightIndex];
+                }
+                rightIndex++;
+            }
+
+            mergeIndex++;
+        }
+    }
+
+    /*
+    Sorts data sequentially with natural merge sort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void mergeSortNatural(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t arrayLength
+    )
+    {
+        if (arrayLength <= 1)
+        {
+            return;
+        }
+
+        // Stack of runs waiting to be merged - start of run and power of node between run and the next run.
+        // Powers on stack are strictly increasing, so stack can't get deeper than the number of bits in length.
+        uint_t stackRunStarts[64];
+        uint_t stackPowers[64];
+        uint_t stackSize = 0;
+
+        uint_t runStart = 0;
+        uint_t runEnd = getRunEnd<sortOrder, sortingKeyOnly>(h_keys, h_values, 0, arrayLength);
+
+        while (runEnd < arrayLength)
+        {
+            uint_t nextRunEnd = getRunEnd<sortOrder, sortingKeyOnly>(h_keys, h_values, runEnd, arrayLength);
+            uint_t power = getNodePower(runStart, runEnd, nextRunEnd, arrayLength);
+
+            // Runs with greater node power are merged first
+            while (stackSize > 0 && stackPowers[stackSize - 1] > power)
+            {
+                stackSize--;
+                mergeRuns<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, stackRunStarts[stackSize], runStart, runEnd
+                );
+                runStart = stackRunStarts[stackSize];
+            }
+
+            stackRunStarts[stackSize] = runStart;
+            stackPowers[stackSize] = power;
+            stackSize++;
+
+            runStart = runEnd;
+            runEnd = nextRunEnd;
+        }
+
+        // Merges remaining runs on stack
+        while (stackSize > 0)
+        {
+            stackSize--;
+            mergeRuns<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, stackRunStarts[stackSize], runStart, arrayLength
+            );
+            runStart = stackRunStarts[stackSize];
+        }
+    }
+
+    /*
+    Wrapper for natural merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortNatural<ORDER_ASC, true>(_h_keys, NULL, _h_keysBuffer, NULL, _arrayLength);
+        }
+        else
+        {
+            mergeSortNatural<ORDER_DESC, true>(_h_keys, NULL, _h_keysBuffer, NULL, _arrayLength);
+        }
+    }
+
+    /*
+    Wrapper for natural merge sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            mergeSortNatural<ORDER_ASC, false>(_h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength);
+        }
+        else
+        {
+            mergeSortNatural<ORDER_DESC, false>(_h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _arrayLength);
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+};
+
+#endif
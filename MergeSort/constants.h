@@ -63,4 +63,55 @@ _KV: Key-value
 #endif
 
 
+/* ------------- NATURAL MERGE SORT ------------------ */
+
+// Runs shorter than this length are extended with insertion sort before they are merged.
+#if DATA_TYPE_BITS == 32
+#define MIN_RUN_LENGTH_NATURAL 32
+#else
+#define MIN_RUN_LENGTH_NATURAL 32
+#endif
+
+/* ------------- MULTIWAY MERGE SORT ----------------- */
+
+// Runs of this length are sorted with pairwise merge sort before they are merged with loser tree. Runs (with
+// buffers) should fit into L2 cache.
+#if DATA_TYPE_BITS == 32
+#define INITIAL_RUN_LENGTH_MULTIWAY (1 << 14)
+#else
+#define INITIAL_RUN_LENGTH_MULTIWAY (1 << 13)
+#endif
+// Max number of runs merged at once with loser tree. Has to be power of 2. More ways save passes through memory,
+// but every element walks one more level of loser tree and more input streams compete for L1 cache.
+#define MAX_WAYS_MULTIWAY 16
+// Size of L1 cache in bytes, which is used if it can't be detected on host.
+#define DEFAULT_CACHE_SIZE_L1_MULTIWAY (32 * 1024)
+
+/* ------------- IN-PLACE MERGE SORT ---------------- */
+
+// Runs of this length are sorted with insertion sort before they are merged.
+#if DATA_TYPE_BITS == 32
+#define INSERTION_SORT_LENGTH_IN_PLACE 16
+#else
+#define INSERTION_SORT_LENGTH_IN_PLACE 16
+#endif
+// Min length of buffer used for merges. Buffer length is max(this value, sqrt(arrayLength)).
+#define MIN_BUFFER_LENGTH_IN_PLACE 256
+// Tag, with which block index is marked in block order array, after block was moved to its position in block merge.
+#define BLOCK_MOVED_IN_PLACE 0x80000000
+
+/* ------- MULTITHREADED ALGORITHM PARAMETERS -------- */
+
+// How many host threads are used. If 0, the number of concurrent threads supported by host is used.
+#define NUM_THREADS_MULTITHREADED_MERGE 0
+// Minimum number of elements merged by one thread. Limits the number of threads used for short arrays.
+#if DATA_TYPE_BITS == 32
+#define MIN_ELEMS_PER_THREAD_MULTITHREADED_KO (1 << 14)
+#define MIN_ELEMS_PER_THREAD_MULTITHREADED_KV (1 << 13)
+#else
+#define MIN_ELEMS_PER_THREAD_MULTITHREADED_KO (1 << 13)
+#define MIN_ELEMS_PER_THREAD_MULTITHREADED_KV (1 << 13)
+#endif
+
+
 #endif
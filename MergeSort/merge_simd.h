@@ -0,0 +1,265 @@
+#ifndef MERGE_SIMD_MERGE_SORT_H
+#define MERGE_SIMD_MERGE_SORT_H
+
+#include <algorithm>
+
+#include "../Utils/data_types_common.h"
+#include "../Utils/host.h"
+#include "../Utils/simd.h"
+
+
+/*
+Merge kernels for key-only blocks. Blocks are merged with bitonic merge networks in SIMD registers: vectors of the
+smallest keys are merged with vector of keys left over from previous merge. Next vector is always loaded from the
+block with smaller next key. Networks aren't stable, which doesn't matter for keys only.
+*/
+
+/*
+Branch-free scalar merge of two sorted blocks into output array.
+*/
+template <order_t sortOrder>
+inline void mergeKeysScalar(data_t *oddKeys, uint_t oddLen, data_t *evenKeys, uint_t evenLen, data_t *output)
+{
+    uint_t oddIndex = 0, evenIndex = 0, mergeIndex = 0;
+
+    while (oddIndex < oddLen && evenIndex < evenLen)
+    {
+        data_t oddElement = oddKeys[oddIndex];
+        data_t evenElement = evenKeys[evenIndex];
+        bool isOddMerged = sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement;
+
+        output[mergeIndex++] = isOddMerged ? oddElement : evenElement;
+        oddIndex += isOddMerged;
+        evenIndex += !isOddMerged;
+    }
+
+    std::copy(oddKeys + oddIndex, oddKeys + oddLen, output + mergeIndex);
+    std::copy(evenKeys + evenIndex, evenKeys + evenLen, output + mergeIndex + oddLen - oddIndex);
+}
+
+/*
+Merges the rest of blocks, which remained after vector merge. Keys left over in registers ("carry") are merged with
+the shorter rest, then the result is merged with the longer rest.
+*/
+template <order_t sortOrder, uint_t vectorLen>
+inline void mergeKeysTail(
+    data_t *carry, data_t *oddKeys, uint_t oddLen, data_t *evenKeys, uint_t evenLen, data_t *output
+)
+{
+    data_t tail[2 * vectorLen];
+
+    if (oddLen < vectorLen)
+    {
+        mergeKeysScalar<sortOrder>(carry, vectorLen, oddKeys, oddLen, tail);
+        mergeKeysScalar<sortOrder>(tail, vectorLen + oddLen, evenKeys, evenLen, output);
+    }
+    else
+    {
+        mergeKeysScalar<sortOrder>(carry, vectorLen, evenKeys, evenLen, tail);
+        mergeKeysScalar<sortOrder>(oddKeys, oddLen, tail, vectorLen + evenLen, output);
+    }
+}
+
+#if DATA_TYPE_BITS == 32
+
+/*
+Compare-exchange of vectors of 8 keys. Keys, which come first in sort order, are stored to "lo", other keys to "hi".
+*/
+template <order_t sortOrder>
+TARGET_AVX2 inline void compareExchangeAvx2(__m256i a, __m256i b, __m256i &lo, __m256i &hi)
+{
+    lo = sortOrder == ORDER_ASC ? _mm256_min_epu32(a, b) : _mm256_max_epu32(a, b);
+    hi = sortOrder == ORDER_ASC ? _mm256_max_epu32(a, b) : _mm256_min_epu32(a, b);
+}
+
+/*
+Sorts bitonic sequence of 8 keys in vector.
+*/
+template <order_t sortOrder>
+TARGET_AVX2 inline __m256i bitonicMergeVectorAvx2(__m256i keys)
+{
+    __m256i lo, hi;
+
+    compareExchangeAvx2<sortOrder>(keys, _mm256_permute2x128_si256(keys, keys, 0x01), lo, hi);
+    keys = _mm256_blend_epi32(lo, hi, 0xF0);
+    compareExchangeAvx2<sortOrder>(keys, _mm256_shuffle_epi32(keys, _MM_SHUFFLE(1, 0, 3, 2)), lo, hi);
+    keys = _mm256_blend_epi32(lo, hi, 0xCC);
+    compareExchangeAvx2<sortOrder>(keys, _mm256_shuffle_epi32(keys, _MM_SHUFFLE(2, 3, 0, 1)), lo, hi);
+    return _mm256_blend_epi32(lo, hi, 0xAA);
+}
+
+/*
+Merges two sorted vectors of 8 keys. First 8 keys of result are stored to "keys1" and last 8 keys to "keys2".
+*/
+template <order_t sortOrder>
+TARGET_AVX2 inline void bitonicMergeAvx2(__m256i &keys1, __m256i &keys2)
+{
+    __m256i lo, hi;
+
+    // Reversed second vector forms bitonic sequence with first vector
+    keys2 = _mm256_permutevar8x32_epi32(keys2, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    compareExchangeAvx2<sortOrder>(keys1, keys2, lo, hi);
+    keys1 = bitonicMergeVectorAvx2<sortOrder>(lo);
+    keys2 = bitonicMergeVectorAvx2<sortOrder>(hi);
+}
+
+/*
+Merges two sorted blocks of keys into output array with AVX2 merge networks.
+*/
+template <order_t sortOrder>
+TARGET_AVX2 void mergeKeysAvx2(data_t *oddKeys, uint_t oddLen, data_t *evenKeys, uint_t evenLen, data_t *output)
+{
+    const uint_t vectorLen = 8;
+
+    if (oddLen < vectorLen || evenLen < vectorLen)
+    {
+        mergeKeysScalar<sortOrder>(oddKeys, oddLen, evenKeys, evenLen, output);
+        return;
+    }
+
+    __m256i keysMerged = _mm256_loadu_si256((__m256i*)oddKeys);
+    __m256i keysCarry = _mm256_loadu_si256((__m256i*)evenKeys);
+    uint_t oddIndex = vectorLen, evenIndex = vectorLen, mergeIndex = 0;
+
+    bitonicMergeAvx2<sortOrder>(keysMerged, keysCarry);
+    _mm256_storeu_si256((__m256i*)output, keysMerged);
+    mergeIndex += vectorLen;
+
+    while (oddIndex + vectorLen <= oddLen && evenIndex + vectorLen <= evenLen)
+    {
+        data_t oddElement = oddKeys[oddIndex];
+        data_t evenElement = evenKeys[evenIndex];
+        bool isOddMerged = sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement;
+        data_t *keys = isOddMerged ? oddKeys + oddIndex : evenKeys + evenIndex;
+
+        keysMerged = _mm256_loadu_si256((__m256i*)keys);
+        oddIndex += isOddMerged ? vectorLen : 0;
+        evenIndex += isOddMerged ? 0 : vectorLen;
+
+        bitonicMergeAvx2<sortOrder>(keysMerged, keysCarry);
+        _mm256_storeu_si256((__m256i*)(output + mergeIndex), keysMerged);
+        mergeIndex += vectorLen;
+    }
+
+    data_t carry[vectorLen];
+    _mm256_storeu_si256((__m256i*)carry, keysCarry);
+    mergeKeysTail<sortOrder, vectorLen>(
+        carry, oddKeys + oddIndex, oddLen - oddIndex, evenKeys + evenIndex, evenLen - evenIndex,
+        output + mergeIndex
+    );
+}
+
+/*
+Compare-exchange of vector of 16 keys with its permutation. Keys on positions in mask get the keys, which come
+later in sort order.
+*/
+template <order_t sortOrder>
+TARGET_AVX512 inline __m512i compareExchangeAvx512(__m512i keys, __m512i permutation, __mmask16 mask)
+{
+    __m512i keysPermuted = _mm512_permutexvar_epi32(permutation, keys);
+    __m512i lo = sortOrder == ORDER_ASC ? _mm512_min_epu32(keys, keysPermuted) : _mm512_max_epu32(keys, keysPermuted);
+    __m512i hi = sortOrder == ORDER_ASC ? _mm512_max_epu32(keys, keysPermuted) : _mm512_min_epu32(keys, keysPermuted);
+    return _mm512_mask_blend_epi32(mask, lo, hi);
+}
+
+/*
+Merges two sorted vectors of 16 keys. First 16 keys of result are stored to "keys1" and last 16 keys to "keys2".
+*/
+template <order_t sortOrder>
+TARGET_AVX512 inline void bitonicMergeAvx512(__m512i &keys1, __m512i &keys2)
+{
+    const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i exchange8 = _mm512_set_epi32(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m512i exchange4 = _mm512_set_epi32(11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4);
+    const __m512i exchange2 = _mm512_set_epi32(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    const __m512i exchange1 = _mm512_set_epi32(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+
+    // Reversed second vector forms bitonic sequence with first vector
+    keys2 = _mm512_permutexvar_epi32(reverse, keys2);
+    __m512i lo = sortOrder == ORDER_ASC ? _mm512_min_epu32(keys1, keys2) : _mm512_max_epu32(keys1, keys2);
+    __m512i hi = sortOrder == ORDER_ASC ? _mm512_max_epu32(keys1, keys2) : _mm512_min_epu32(keys1, keys2);
+
+    lo = compareExchangeAvx512<sortOrder>(lo, exchange8, 0xFF00);
+    hi = compareExchangeAvx512<sortOrder>(hi, exchange8, 0xFF00);
+    lo = compareExchangeAvx512<sortOrder>(lo, exchange4, 0xF0F0);
+    hi = compareExchangeAvx512<sortOrder>(hi, exchange4, 0xF0F0);
+    lo = compareExchangeAvx512<sortOrder>(lo, exchange2, 0xCCCC);
+    hi = compareExchangeAvx512<sortOrder>(hi, exchange2, 0xCCCC);
+    keys1 = compareExchangeAvx512<sortOrder>(lo, exchange1, 0xAAAA);
+    keys2 = compareExchangeAvx512<sortOrder>(hi, exchange1, 0xAAAA);
+}
+
+/*
+Merges two sorted blocks of keys into output array with AVX-512 merge networks.
+*/
+template <order_t sortOrder>
+TARGET_AVX512 void mergeKeysAvx512(data_t *oddKeys, uint_t oddLen, data_t *evenKeys, uint_t evenLen, data_t *output)
+{
+    const uint_t vectorLen = 16;
+
+    if (oddLen < vectorLen || evenLen < vectorLen)
+    {
+        mergeKeysScalar<sortOrder>(oddKeys, oddLen, evenKeys, evenLen, output);
+        return;
+    }
+
+    __m512i keysMerged = _mm512_loadu_si512(oddKeys);
+    __m512i keysCarry = _mm512_loadu_si512(evenKeys);
+    uint_t oddIndex = vectorLen, evenIndex = vectorLen, mergeIndex = 0;
+
+    bitonicMergeAvx512<sortOrder>(keysMerged, keysCarry);
+    _mm512_storeu_si512(output, keysMerged);
+    mergeIndex += vectorLen;
+
+    while (oddIndex + vectorLen <= oddLen && evenIndex + vectorLen <= evenLen)
+    {
+        data_t oddElement = oddKeys[oddIndex];
+        data_t evenElement = evenKeys[evenIndex];
+        bool isOddMerged = sortOrder == ORDER_ASC ? oddElement <= evenElement : oddElement >= evenElement;
+        data_t *keys = isOddMerged ? oddKeys + oddIndex : evenKeys + evenIndex;
+
+        keysMerged = _mm512_loadu_si512(keys);
+        oddIndex += isOddMerged ? vectorLen : 0;
+        evenIndex += isOddMerged ? 0 : vectorLen;
+
+        bitonicMergeAvx512<sortOrder>(keysMerged, keysCarry);
+        _mm512_storeu_si512(output + mergeIndex, keysMerged);
+        mergeIndex += vectorLen;
+    }
+
+    data_t carry[vectorLen];
+    _mm512_storeu_si512(carry, keysCarry);
+    mergeKeysTail<sortOrder, vectorLen>(
+        carry, oddKeys + oddIndex, oddLen - oddIndex, evenKeys + evenIndex, evenLen - evenIndex,
+        output + mergeIndex
+    );
+}
+
+#endif
+
+/*
+Merges two sorted blocks of keys into output array with the widest merge kernel supported by host.
+*/
+template <order_t sortOrder>
+void mergeKeys(data_t *oddKeys, uint_t oddLen, data_t *evenKeys, uint_t evenLen, data_t *output)
+{
+#if DATA_TYPE_BITS == 32
+    static const bool isAvx512Supported = isHostAvx512Supported();
+    static const bool isAvx2Supported = isHostAvx2Supported();
+
+    if (isAvx512Supported)
+    {
+        mergeKeysAvx512<sortOrder>(oddKeys, oddLen, evenKeys, evenLen, output);
+        return;
+    }
+    if (isAvx2Supported)
+    {
+        mergeKeysAvx2<sortOrder>(oddKeys, oddLen, evenKeys, evenLen, output);
+        return;
+    }
+#endif
+
+    mergeKeysScalar<sortOrder>(oddKeys, oddLen, evenKeys, evenLen, output);
+}
+
+#endif
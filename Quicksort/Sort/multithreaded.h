@@ -0,0 +1,461 @@
+#ifndef QUICKSORT_MULTITHREADED_H
+#define QUICKSORT_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "../data_types.h"
+#include "sequential.h"
+
+
+/*
+Class for multithreaded quicksort on host.
+Long sequences are partitioned cooperatively by all threads: every thread partitions its chunk of sequence and
+after that the misplaced elements of all chunks are exchanged in parallel. When sequences get short enough, they
+are distributed to per-thread deques. Every thread takes sequences from the back of its own deque, partitions
+them and pushes one of the partitions back to deque, until sequence is shorter than grain size. Then it is sorted
+with sequential quicksort. Idle threads steal the oldest (longest) sequences from the front of other deques, so
+threads don't wait for the longest partition also for skewed distributions.
+*/
+class QuicksortMultithreaded : public QuicksortSequential
+{
+protected:
+    std::string _sortName = "Quicksort multithreaded";
+    // Number of host threads used for sort
+    uint_t _numThreads = NUM_THREADS_MULTITHREADED_QUICKSORT > 0
+        ? NUM_THREADS_MULTITHREADED_QUICKSORT
+        : getNumHostThreads();
+
+    /*
+    Deque of sequences, which belongs to one thread.
+    */
+    struct SequenceDeque
+    {
+        std::mutex mutex;
+        std::deque<thr_seq_t> sequences;
+    };
+
+    /*
+    Takes the newest sequence from the back of thread's own deque. Returns false, if deque is empty.
+    */
+    bool popSequence(SequenceDeque &deque, thr_seq_t &sequence)
+    {
+        std::lock_guard<std::mutex> lock(deque.mutex);
+
+        if (deque.sequences.empty())
+        {
+            return false;
+        }
+
+        sequence = deque.sequences.back();
+        deque.sequences.pop_back();
+        return true;
+    }
+
+    /*
+    Steals the oldest sequence from the front of other threads' deques. Returns false, if all deques are empty.
+    */
+    bool stealSequence(std::vector<SequenceDeque> &deques, uint_t threadIndex, thr_seq_t &sequence)
+    {
+        for (uint_t i = 1; i < deques.size(); i++)
+        {
+            SequenceDeque &deque = deques[(threadIndex + i) % deques.size()];
+            std::lock_guard<std::mutex> lock(deque.mutex);
+
+            if (!deque.sequences.empty())
+            {
+                sequence = deque.sequences.front();
+                deque.sequences.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*
+    Pushes sequence to the back of thread's own deque.
+    */
+    void pushSequence(SequenceDeque &deque, thr_seq_t sequence)
+    {
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        deque.sequences.push_back(sequence);
+    }
+
+    /*
+    Partitions keys (and values) into 2 partitions - elements lower and elements greater or equal than pivot value
+    - with all threads. Every thread partitions its chunk of array with block partitioning. After that greater
+    elements located in lower partition are exchanged with lower elements located in greater partition, where
+    every thread exchanges equal number of elements. Returns the length of lower partition.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    uint_t partitionCooperative(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, data_t pivotValue, uint_t numThreads
+    )
+    {
+        std::vector<uint_t> chunkLowerLengths(numThreads);
+
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            uint_t chunkStart = getThreadChunkStart(threadIndex, numThreads, arrayLength);
+            uint_t chunkEnd = getThreadChunkEnd(threadIndex, numThreads, arrayLength);
+
+            chunkLowerLengths[threadIndex] = partitionBlock<sortOrder, sortingKeyOnly>(
+                h_keys + chunkStart, sortingKeyOnly ? NULL : h_values + chunkStart, chunkEnd - chunkStart,
+                pivotValue
+            );
+        });
+
+        uint_t lowerLength = 0;
+        for (uint_t i = 0; i < numThreads; i++)
+        {
+            lowerLength += chunkLowerLengths[i];
+        }
+
+        // Every chunk contains at most one interval of misplaced greater and one interval of misplaced lower
+        // elements. Intervals are stored in ascending order.
+        std::vector<uint_t> greaterStarts, greaterEnds, lowerStarts, lowerEnds;
+        uint_t numMisplaced = 0;
+
+        for (uint_t i = 0; i < numThreads; i++)
+        {
+            uint_t chunkStart = getThreadChunkStart(i, numThreads, arrayLength);
+            uint_t chunkEnd = getThreadChunkEnd(i, numThreads, arrayLength);
+            uint_t chunkSplit = chunkStart + chunkLowerLengths[i];
+
+            if (chunkSplit < lowerLength && chunkSplit < chunkEnd)
+            {
+                greaterStarts.push_back(chunkSplit);
+                greaterEnds.push_back(std::min(chunkEnd, lowerLength));
+                numMisplaced += greaterEnds.back() - greaterStarts.back();
+            }
+            if (std::max(chunkStart, lowerLength) < chunkSplit)
+            {
+                lowerStarts.push_back(std::max(chunkStart, lowerLength));
+                lowerEnds.push_back(chunkSplit);
+            }
+        }
+
+        if (numMisplaced == 0)
+        {
+            return lowerLength;
+        }
+
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            uint_t misplacedStart = getThreadChunkStart(threadIndex, numThreads, numMisplaced);
+            uint_t misplacedEnd = getThreadChunkEnd(threadIndex, numThreads, numMisplaced);
+            uint_t greaterInterval = 0, lowerInterval = 0;
+            uint_t greaterIndex = greaterStarts[0], lowerIndex = lowerStarts[0];
+
+            // Skips the misplaced elements exchanged by previous threads
+            for (uint_t skip = misplacedStart; skip > 0; )
+            {
+                uint_t length = std::min(skip, greaterEnds[greaterInterval] - greaterIndex);
+                greaterIndex += length;
+                skip -= length;
+
+                if (greaterIndex == greaterEnds[greaterInterval] && skip > 0)
+                {
+                    greaterIndex = greaterStarts[++greaterInterval];
+                }
+            }
+            for (uint_t skip = misplacedStart; skip > 0; )
+            {
+                uint_t length = std::min(skip, lowerEnds[lowerInterval] - lowerIndex);
+                lowerIndex += length;
+                skip -= length;
+
+                if (lowerIndex == lowerEnds[lowerInterval] && skip > 0)
+                {
+                    lowerIndex = lowerStarts[++lowerInterval];
+                }
+            }
+
+            for (uint_t i = misplacedStart; i < misplacedEnd; i++)
+            {
+                if (greaterIndex == greaterEnds[greaterInterval])
+                {
+                    greaterIndex = greaterStarts[++greaterInterval];
+                }
+                if (lowerIndex == lowerEnds[lowerInterval])
+                {
+                    lowerIndex = lowerStarts[++lowerInterval];
+                }
+
+                exchangeElemens(&h_keys[greaterIndex], &h_keys[lowerIndex]);
+                if (!sortingKeyOnly)
+                {
+                    exchangeElemens(&h_values[greaterIndex], &h_values[lowerIndex]);
+                }
+
+                greaterIndex++;
+                lowerIndex++;
+            }
+        });
+
+        return lowerLength;
+    }
+
+    /*
+    Partitions long sequences cooperatively with all threads, until they are short enough to be sorted by one
+    thread. Returns sequences, which have to be sorted.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    std::vector<thr_seq_t> partitionSequencesCooperative(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t numThreads, uint_t minElemsPerThread
+    )
+    {
+        std::vector<thr_seq_t> sequencesLong, sequencesShort;
+        uint_t thresholdCooperative = std::max(arrayLength / numThreads, numThreads * minElemsPerThread);
+
+        sequencesLong.push_back({0, arrayLength, getDepthLimit(arrayLength), true});
+
+        while (!sequencesLong.empty())
+        {
+            thr_seq_t sequence = sequencesLong.back();
+            sequencesLong.pop_back();
+
+            if (numThreads == 1 || sequence.length <= thresholdCooperative || sequence.depthLimit == 0)
+            {
+                sequencesShort.push_back(sequence);
+                continue;
+            }
+
+            data_t *keys = h_keys + sequence.start;
+            data_t *values = sortingKeyOnly ? NULL : h_values + sequence.start;
+            uint_t pivotIndex = getPivotIndex(keys, sequence.length);
+            uint_t indexLast = sequence.length - 1;
+            data_t pivotValue = keys[pivotIndex];
+
+            // Pivot is excluded from partitioning and moved between partitions afterwards. This way the element
+            // before greater partition is already at its final position and sequential partitioning of greater
+            // partition can read it, while other threads are partitioning lower partition.
+            exchangeElemens(&keys[pivotIndex], &keys[indexLast]);
+            if (!sortingKeyOnly)
+            {
+                exchangeElemens(&values[pivotIndex], &values[indexLast]);
+            }
+
+            uint_t lowerLength = partitionCooperative<sortOrder, sortingKeyOnly>(
+                keys, values, indexLast, pivotValue, numThreads
+            );
+            uint_t greaterStart = lowerLength + 1;
+            bool isLowerSorted = false;
+
+            // If pivot is the lowest element, elements equal to pivot are moved to lower partition, which is
+            // sorted after that. Keys are integers, so elements lower than "pivot + 1" are lower or equal than pivot.
+            if (lowerLength == 0)
+            {
+                if (pivotValue == (sortOrder == ORDER_ASC ? MAX_VAL : MIN_VAL))
+                {
+                    continue;
+                }
+
+                lowerLength = partitionCooperative<sortOrder, sortingKeyOnly>(
+                    keys, values, sequence.length, sortOrder == ORDER_ASC ? pivotValue + 1 : pivotValue - 1,
+                    numThreads
+                );
+                greaterStart = lowerLength;
+                isLowerSorted = true;
+            }
+            else
+            {
+                exchangeElemens(&keys[lowerLength], &keys[indexLast]);
+                if (!sortingKeyOnly)
+                {
+                    exchangeElemens(&values[lowerLength], &values[indexLast]);
+                }
+            }
+
+            thr_seq_t sequenceLower = {sequence.start, lowerLength, sequence.depthLimit - 1, sequence.isLeftmost};
+            thr_seq_t sequenceGreater = {
+                sequence.start + greaterStart, sequence.length - greaterStart, sequence.depthLimit - 1, false
+            };
+
+            if (!isLowerSorted)
+            {
+                sequencesLong.push_back(sequenceLower);
+            }
+            sequencesLong.push_back(sequenceGreater);
+        }
+
+        return sequencesShort;
+    }
+
+    /*
+    Sorts sequence by one thread. Until sequence is shorter than grain size, it is partitioned and the longer
+    partition is pushed to thread's deque, where it can be stolen by other threads.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void sortSequence(
+        data_t *h_keys, data_t *h_values, thr_seq_t sequence, SequenceDeque &deque,
+        std::atomic<uint_t> &numSequencesPending, uint_t grainSize
+    )
+    {
+        while (sequence.length > grainSize && sequence.depthLimit > 0)
+        {
+            data_t *keys = h_keys + sequence.start;
+            data_t *values = sortingKeyOnly ? NULL : h_values + sequence.start;
+            uint_t lowerLength, greaterLength;
+
+            partitionStep<sortOrder, sortingKeyOnly>(
+                keys, values, sequence.length, sequence.isLeftmost, lowerLength, greaterLength
+            );
+
+            uint_t depthLimit = sequence.depthLimit - 1;
+            thr_seq_t sequenceLower = {sequence.start, lowerLength, depthLimit, sequence.isLeftmost};
+            thr_seq_t sequenceGreater = {
+                sequence.start + sequence.length - greaterLength, greaterLength, depthLimit, false
+            };
+
+            // Counter has to be incremented before push, so that other threads don't finish prematurely
+            numSequencesPending++;
+            if (lowerLength < greaterLength)
+            {
+                pushSequence(deque, sequenceGreater);
+                sequence = sequenceLower;
+            }
+            else
+            {
+                pushSequence(deque, sequenceLower);
+                sequence = sequenceGreater;
+            }
+        }
+
+        data_t *keys = h_keys + sequence.start;
+        if (sortingKeyOnly)
+        {
+            quicksortSequential<sortOrder>(keys, sequence.length, sequence.depthLimit, sequence.isLeftmost);
+        }
+        else
+        {
+            quicksortSequential<sortOrder>(
+                keys, h_values + sequence.start, sequence.length, sequence.depthLimit, sequence.isLeftmost
+            );
+        }
+    }
+
+    /*
+    Sorts data with multithreaded quicksort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void quicksortMultithreaded(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t numThreads, uint_t minElemsPerThread,
+        uint_t grainSize
+    )
+    {
+        if (arrayLength <= 1)
+        {
+            return;
+        }
+
+        std::vector<thr_seq_t> sequences = partitionSequencesCooperative<sortOrder, sortingKeyOnly>(
+            h_keys, h_values, arrayLength, numThreads, minElemsPerThread
+        );
+
+        // Longest sequences are distributed first, so that deques contain equal amount of work
+        std::sort(sequences.begin(), sequences.end(), [](const thr_seq_t &seq1, const thr_seq_t &seq2)
+        {
+            return seq1.length < seq2.length;
+        });
+
+        std::vector<SequenceDeque> deques(numThreads);
+        std::atomic<uint_t> numSequencesPending((uint_t)sequences.size());
+
+        for (uint_t i = 0; i < sequences.size(); i++)
+        {
+            deques[(sequences.size() - i - 1) % numThreads].sequences.push_back(sequences[i]);
+        }
+
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            thr_seq_t sequence;
+
+            while (numSequencesPending > 0)
+            {
+                if (!popSequence(deques[threadIndex], sequence) && !stealSequence(deques, threadIndex, sequence))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                sortSequence<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, sequence, deques[threadIndex], numSequencesPending, grainSize
+                );
+                numSequencesPending--;
+            }
+        });
+    }
+
+    /*
+    Wrapper for multithreaded quicksort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            quicksortMultithreaded<ORDER_ASC, true>(
+                _h_keys, NULL, _arrayLength, _numThreads, MIN_ELEMS_PER_THREAD_COOPERATIVE_KO,
+                GRAIN_SIZE_MULTITHREADED_KO
+            );
+        }
+        else
+        {
+            quicksortMultithreaded<ORDER_DESC, true>(
+                _h_keys, NULL, _arrayLength, _numThreads, MIN_ELEMS_PER_THREAD_COOPERATIVE_KO,
+                GRAIN_SIZE_MULTITHREADED_KO
+            );
+        }
+    }
+
+    /*
+    Wrapper for multithreaded quicksort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            quicksortMultithreaded<ORDER_ASC, false>(
+                _h_keys, _h_values, _arrayLength, _numThreads, MIN_ELEMS_PER_THREAD_COOPERATIVE_KV,
+                GRAIN_SIZE_MULTITHREADED_KV
+            );
+        }
+        else
+        {
+            quicksortMultithreaded<ORDER_DESC, false>(
+                _h_keys, _h_values, _arrayLength, _numThreads, MIN_ELEMS_PER_THREAD_COOPERATIVE_KV,
+                GRAIN_SIZE_MULTITHREADED_KV
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Sets the number of host threads used for sort.
+    */
+    void setNumThreads(uint_t numThreads)
+    {
+        _numThreads = numThreads > 0 ? numThreads : 1;
+    }
+};
+
+#endif
@@ -0,0 +1,533 @@
+#ifndef QUICKSORT_MULTITHREADED_GLOBAL_H
+#define QUICKSORT_MULTITHREADED_GLOBAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "../data_types.h"
+#include "sequential.h"
+
+
+/*
+Class for multithreaded quicksort on host with the same scheme as parallel quicksort on device. Groups of elements
+processed by host threads replace thread blocks.
+GLOBAL step: long sequences are split into groups, which are distributed dynamically among threads. Pivot is the
+average of sequence's min and max value. Every group counts elements lower/greater than pivot, reserves space for
+them with atomic counters "offsetLower"/"offsetGreater" of its sequence and scatters them to the other array
+(primary array or buffer). The last group of sequence stores pivots to their final positions in primary array.
+LOCAL step: short sequences are copied to primary array (if needed) and sorted by one thread with sequential
+quicksort.
+*/
+class QuicksortMultithreadedGlobal : public QuicksortSequential
+{
+protected:
+    std::string _sortName = "Quicksort multithreaded global/local";
+    // Number of host threads used for sort
+    uint_t _numThreads = NUM_THREADS_MULTITHREADED_QUICKSORT > 0
+        ? NUM_THREADS_MULTITHREADED_QUICKSORT
+        : getNumHostThreads();
+
+    // Buffer for keys and values, to which sequences are scattered in global step
+    data_t *_h_keysBuffer = NULL;
+    data_t *_h_valuesBuffer = NULL;
+    // Values of pivots are stored here, until the last group of sequence knows their final positions
+    data_t *_h_valuesPivot = NULL;
+    // Length of value buffers, which are allocated only when key-value pairs are sorted
+    uint_t _valuesBufferLength = 0;
+
+    /*
+    Counters of sequence in GLOBAL step, which are shared by all groups of sequence (see "DeviceGlobalSequence").
+    */
+    struct SequenceCounters
+    {
+        std::atomic<uint_t> groupCounter;
+        std::atomic<uint_t> offsetLower;
+        std::atomic<uint_t> offsetGreater;
+        std::atomic<uint_t> offsetPivotValues;
+    };
+
+    void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
+
+        _h_keysBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_keysBuffer));
+        checkMallocError(_h_keysBuffer);
+    }
+
+    /*
+    Allocates value buffers on first key-value sort (or when array is longer than before), so that key only sort
+    doesn't allocate memory for values.
+    */
+    void memoryAllocateValues(uint_t arrayLength)
+    {
+        if (arrayLength <= _valuesBufferLength)
+        {
+            return;
+        }
+
+        free(_h_valuesBuffer);
+        free(_h_valuesPivot);
+
+        _h_valuesBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_valuesBuffer));
+        checkMallocError(_h_valuesBuffer);
+        _h_valuesPivot = (data_t*)malloc(arrayLength * sizeof(*_h_valuesPivot));
+        checkMallocError(_h_valuesPivot);
+        _valuesBufferLength = arrayLength;
+    }
+
+    /*
+    Searches for min/max values in array with all threads.
+    */
+    void minMaxReduction(data_t *h_keys, uint_t arrayLength, uint_t numThreads, data_t &minVal, data_t &maxVal)
+    {
+        std::vector<data_t> minValues(numThreads), maxValues(numThreads);
+
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            uint_t chunkStart = getThreadChunkStart(threadIndex, numThreads, arrayLength);
+            uint_t chunkEnd = getThreadChunkEnd(threadIndex, numThreads, arrayLength);
+            data_t threadMinVal = MAX_VAL;
+            data_t threadMaxVal = MIN_VAL;
+
+            for (uint_t i = chunkStart; i < chunkEnd; i++)
+            {
+                threadMinVal = std::min(threadMinVal, h_keys[i]);
+                threadMaxVal = std::max(threadMaxVal, h_keys[i]);
+            }
+
+            minValues[threadIndex] = threadMinVal;
+            maxValues[threadIndex] = threadMaxVal;
+        });
+
+        minVal = MAX_VAL;
+        maxVal = MIN_VAL;
+
+        for (uint_t i = 0; i < numThreads; i++)
+        {
+            minVal = std::min(minVal, minValues[i]);
+            maxVal = std::max(maxVal, maxValues[i]);
+        }
+    }
+
+    /*
+    Partitions one group of sequence in GLOBAL step. Elements lower and greater than pivot are first gathered
+    without branches to thread's group buffer and then copied to the start and to the end of sequence in the other
+    array. Values of pivots are copied to pivot buffer. The last group, which finished partitioning of sequence,
+    stores pivots to their final positions in primary array.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void partitionGroupGlobal(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_valuesPivot,
+        data_t *groupBuffer, d_glob_seq_t &sequence, SequenceCounters &counters, uint_t groupIdx,
+        uint_t elemsPerGroup
+    )
+    {
+        bool isInputPrimary = sequence.direction == PRIMARY_MEM_TO_BUFFER;
+        data_t *keysInput = isInputPrimary ? h_keys : h_keysBuffer;
+        data_t *valuesInput = isInputPrimary ? h_values : h_valuesBuffer;
+        data_t *keysOutput = isInputPrimary ? h_keysBuffer : h_keys;
+        data_t *valuesOutput = isInputPrimary ? h_valuesBuffer : h_values;
+
+        uint_t groupStart = sequence.start + (groupIdx - sequence.startThreadBlockIdx) * elemsPerGroup;
+        uint_t groupEnd = std::min(groupStart + elemsPerGroup, sequence.start + sequence.length);
+        data_t pivot = sequence.pivot;
+
+        data_t *keysLower = groupBuffer;
+        data_t *keysGreater = groupBuffer + elemsPerGroup;
+        data_t *valuesLower = groupBuffer + 2 * elemsPerGroup;
+        data_t *valuesGreater = groupBuffer + 3 * elemsPerGroup;
+        data_t *valuesPivot = groupBuffer + 4 * elemsPerGroup;
+        uint_t numLower = 0, numGreater = 0, numPivots = 0;
+
+        for (uint_t i = groupStart; i < groupEnd; i++)
+        {
+            data_t key = keysInput[i];
+            bool isLower = !isOrdered<sortOrder>(pivot, key);
+            bool isGreater = !isOrdered<sortOrder>(key, pivot);
+
+            keysLower[numLower] = key;
+            keysGreater[numGreater] = key;
+            if (!sortingKeyOnly)
+            {
+                data_t value = valuesInput[i];
+                valuesLower[numLower] = value;
+                valuesGreater[numGreater] = value;
+                valuesPivot[numPivots] = value;
+                numPivots += !isLower && !isGreater;
+            }
+
+            numLower += isLower;
+            numGreater += isGreater;
+        }
+
+        // Reserves space for elements of group. Greater elements are located at the end of sequence.
+        uint_t indexLower = sequence.start + counters.offsetLower.fetch_add(numLower);
+        uint_t indexGreater = sequence.start + sequence.length - counters.offsetGreater.fetch_add(numGreater);
+        indexGreater -= numGreater;
+
+        memcpy(keysOutput + indexLower, keysLower, numLower * sizeof(*keysOutput));
+        memcpy(keysOutput + indexGreater, keysGreater, numGreater * sizeof(*keysOutput));
+        if (!sortingKeyOnly)
+        {
+            uint_t indexPivot = sequence.start + counters.offsetPivotValues.fetch_add(numPivots);
+
+            memcpy(valuesOutput + indexLower, valuesLower, numLower * sizeof(*valuesOutput));
+            memcpy(valuesOutput + indexGreater, valuesGreater, numGreater * sizeof(*valuesOutput));
+            memcpy(h_valuesPivot + indexPivot, valuesPivot, numPivots * sizeof(*h_valuesPivot));
+        }
+
+        // Other groups of sequence have finished reading it, so pivots can be stored also to input array
+        if (counters.groupCounter.fetch_sub(1) != 1)
+        {
+            return;
+        }
+
+        uint_t pivotsStart = sequence.start + counters.offsetLower;
+        uint_t pivotsEnd = sequence.start + sequence.length - counters.offsetGreater;
+
+        for (uint_t i = pivotsStart; i < pivotsEnd; i++)
+        {
+            h_keys[i] = pivot;
+        }
+        if (!sortingKeyOnly)
+        {
+            memcpy(
+                h_values + pivotsStart, h_valuesPivot + sequence.start,
+                (pivotsEnd - pivotsStart) * sizeof(*h_values)
+            );
+        }
+    }
+
+    /*
+    Runs GLOBAL step (multiple groups process one sequence). Groups are taken by threads from shared counter.
+    After that counters of sequences are stored to "globalSeqDev".
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void runQuickSortGlobalStep(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_valuesPivot,
+        std::vector<d_glob_seq_t> &globalSeqDev, std::vector<uint_t> &globalSeqIndexes, uint_t elemsPerGroup,
+        uint_t numThreads
+    )
+    {
+        std::vector<SequenceCounters> counters(globalSeqDev.size());
+        std::atomic<uint_t> groupCounter(0);
+        uint_t numGroups = (uint_t)globalSeqIndexes.size();
+
+        for (uint_t seqIdx = 0; seqIdx < globalSeqDev.size(); seqIdx++)
+        {
+            counters[seqIdx].groupCounter = globalSeqDev[seqIdx].threadBlockCounter;
+            counters[seqIdx].offsetLower = 0;
+            counters[seqIdx].offsetGreater = 0;
+            counters[seqIdx].offsetPivotValues = 0;
+        }
+
+        runHostThreads(std::min(numThreads, numGroups), [&](uint_t)
+        {
+            std::vector<data_t> groupBuffer((sortingKeyOnly ? 2 : 5) * elemsPerGroup);
+            uint_t groupIdx = groupCounter++;
+
+            while (groupIdx < numGroups)
+            {
+                uint_t seqIdx = globalSeqIndexes[groupIdx];
+
+                partitionGroupGlobal<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_valuesPivot, groupBuffer.data(),
+                    globalSeqDev[seqIdx], counters[seqIdx], groupIdx, elemsPerGroup
+                );
+                groupIdx = groupCounter++;
+            }
+        });
+
+        for (uint_t seqIdx = 0; seqIdx < globalSeqDev.size(); seqIdx++)
+        {
+            globalSeqDev[seqIdx].offsetLower = counters[seqIdx].offsetLower;
+            globalSeqDev[seqIdx].offsetGreater = counters[seqIdx].offsetGreater;
+        }
+    }
+
+    /*
+    Runs LOCAL step (one thread processes one sequence). Sequences located in buffer are copied to primary array.
+    If "isSortNeeded" is false, sequences contain only equal elements and they are only copied.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void runQuickSortLocalStep(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer,
+        std::vector<loc_seq_t> &localSeq, bool isSortNeeded, uint_t numThreads
+    )
+    {
+        if (localSeq.empty())
+        {
+            return;
+        }
+
+        // Longest sequences are sorted first, so that threads finish at the same time
+        std::sort(localSeq.begin(), localSeq.end(), [](const loc_seq_t &seq1, const loc_seq_t &seq2)
+        {
+            return seq1.length > seq2.length;
+        });
+
+        std::atomic<uint_t> seqCounter(0);
+        uint_t numSeqLocal = (uint_t)localSeq.size();
+
+        runHostThreads(std::min(numThreads, numSeqLocal), [&](uint_t)
+        {
+            uint_t seqIdx = seqCounter++;
+
+            while (seqIdx < numSeqLocal)
+            {
+                loc_seq_t sequence = localSeq[seqIdx];
+                data_t *keys = h_keys + sequence.start;
+                data_t *values = sortingKeyOnly ? NULL : h_values + sequence.start;
+
+                if (sequence.direction == BUFFER_TO_PRIMARY_MEM)
+                {
+                    memcpy(keys, h_keysBuffer + sequence.start, sequence.length * sizeof(*keys));
+                    if (!sortingKeyOnly)
+                    {
+                        memcpy(values, h_valuesBuffer + sequence.start, sequence.length * sizeof(*values));
+                    }
+                }
+
+                if (isSortNeeded && sortingKeyOnly)
+                {
+                    quicksortSequential<sortOrder>(keys, sequence.length, getDepthLimit(sequence.length), true);
+                }
+                else if (isSortNeeded)
+                {
+                    quicksortSequential<sortOrder>(
+                        keys, values, sequence.length, getDepthLimit(sequence.length), true
+                    );
+                }
+
+                seqIdx = seqCounter++;
+            }
+        });
+    }
+
+    /*
+    Adds newly generated sequence to list for GLOBAL step, if it is longer than threshold. Otherwise it is added to
+    list for LOCAL step. Sequences, which min and max value are equal, contain only equal elements and don't have
+    to be sorted.
+    */
+    void addSequence(
+        h_glob_seq_t sequence, uint_t thresholdPartitionGlobal, std::vector<h_glob_seq_t> &globalSeqHost,
+        std::vector<loc_seq_t> &localSeq, std::vector<loc_seq_t> &constantSeq
+    )
+    {
+        if (sequence.length == 0)
+        {
+            return;
+        }
+
+        loc_seq_t sequenceLocal = {sequence.start, sequence.length, sequence.direction};
+
+        if (sequence.minVal == sequence.maxVal)
+        {
+            constantSeq.push_back(sequenceLocal);
+        }
+        else if (sequence.length > thresholdPartitionGlobal)
+        {
+            globalSeqHost.push_back(sequence);
+        }
+        else
+        {
+            localSeq.push_back(sequenceLocal);
+        }
+    }
+
+    /*
+    Sorts data with multithreaded global/local quicksort. Sorted data is located in primary array.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void quicksortMultithreadedGlobal(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_valuesPivot,
+        uint_t arrayLength, uint_t numThreads, uint_t thresholdPartitionGlobal, uint_t elemsPerGroup
+    )
+    {
+        if (arrayLength <= 1)
+        {
+            return;
+        }
+
+        std::vector<h_glob_seq_t> globalSeqHost(1), globalSeqHostBuffer;
+        std::vector<d_glob_seq_t> globalSeqDev;
+        std::vector<uint_t> globalSeqIndexes;
+        std::vector<loc_seq_t> localSeq, constantSeq;
+        data_t minVal, maxVal;
+
+        numThreads = std::min(numThreads, (arrayLength - 1) / elemsPerGroup + 1);
+
+        // Searches for min and max value in input array
+        minMaxReduction(h_keys, arrayLength, numThreads, minVal, maxVal);
+        // Null/zero distribution
+        if (minVal == maxVal)
+        {
+            return;
+        }
+        globalSeqHost[0].setInitSeq(arrayLength, minVal, maxVal);
+
+        // If global step isn't needed, than sequence is initialized for LOCAL step
+        if (arrayLength <= thresholdPartitionGlobal)
+        {
+            globalSeqHost.clear();
+            localSeq.resize(1);
+            localSeq[0].setInitSeq(arrayLength);
+        }
+
+        // GLOBAL STEP
+        while (!globalSeqHost.empty())
+        {
+            uint_t groupCounter = 0;
+
+            globalSeqDev.resize(globalSeqHost.size());
+            globalSeqIndexes.clear();
+
+            for (uint_t seqIdx = 0; seqIdx < globalSeqHost.size(); seqIdx++)
+            {
+                uint_t groupsPerSeq = (globalSeqHost[seqIdx].length - 1) / elemsPerGroup + 1;
+                globalSeqDev[seqIdx].setFromHostSeq(globalSeqHost[seqIdx], groupCounter, groupsPerSeq);
+
+                // For all groups in current iteration marks, they are assigned to current sequence.
+                for (uint_t groupIdx = 0; groupIdx < groupsPerSeq; groupIdx++)
+                {
+                    globalSeqIndexes.push_back(seqIdx);
+                }
+                groupCounter += groupsPerSeq;
+            }
+
+            runQuickSortGlobalStep<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_valuesPivot, globalSeqDev, globalSeqIndexes,
+                elemsPerGroup, numThreads
+            );
+
+            globalSeqHostBuffer.clear();
+
+            // Generates new sub-sequences and depending on their size adds them to list for GLOBAL or LOCAL step
+            for (uint_t seqIdx = 0; seqIdx < globalSeqHost.size(); seqIdx++)
+            {
+                h_glob_seq_t seqHost = globalSeqHost[seqIdx];
+                d_glob_seq_t seqDev = globalSeqDev[seqIdx];
+                h_glob_seq_t seqLower, seqGreater;
+
+                seqLower.setLowerSeq(seqHost, seqDev);
+                seqGreater.setGreaterSeq(seqHost, seqDev);
+
+                // Elements equal to pivot are already on their final positions and keys are integers, so pivot
+                // is excluded from value range of new sequences. This way value range always shrinks.
+                if (sortOrder == ORDER_ASC)
+                {
+                    seqLower.maxVal = seqDev.pivot - 1;
+                    seqGreater.minVal = seqDev.pivot + 1;
+                }
+                else
+                {
+                    seqLower.minVal = seqDev.pivot + 1;
+                    seqLower.maxVal = seqHost.maxVal;
+                    seqGreater.minVal = seqHost.minVal;
+                    seqGreater.maxVal = seqDev.pivot - 1;
+                }
+
+                addSequence(seqLower, thresholdPartitionGlobal, globalSeqHostBuffer, localSeq, constantSeq);
+                addSequence(seqGreater, thresholdPartitionGlobal, globalSeqHostBuffer, localSeq, constantSeq);
+            }
+
+            globalSeqHost.swap(globalSeqHostBuffer);
+        }
+
+        // LOCAL STEP
+        runQuickSortLocalStep<sortOrder, sortingKeyOnly>(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, localSeq, true, numThreads
+        );
+        runQuickSortLocalStep<sortOrder, sortingKeyOnly>(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, constantSeq, false, numThreads
+        );
+    }
+
+    /*
+    Wrapper for multithreaded global/local quicksort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            quicksortMultithreadedGlobal<ORDER_ASC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, NULL, _arrayLength, _numThreads,
+                THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KO, ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KO
+            );
+        }
+        else
+        {
+            quicksortMultithreadedGlobal<ORDER_DESC, true>(
+                _h_keys, NULL, _h_keysBuffer, NULL, NULL, _arrayLength, _numThreads,
+                THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KO, ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KO
+            );
+        }
+    }
+
+    /*
+    Wrapper for multithreaded global/local quicksort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        memoryAllocateValues(_arrayLength);
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            quicksortMultithreadedGlobal<ORDER_ASC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_valuesPivot, _arrayLength, _numThreads,
+                THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KV, ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KV
+            );
+        }
+        else
+        {
+            quicksortMultithreadedGlobal<ORDER_DESC, false>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_valuesPivot, _arrayLength, _numThreads,
+                THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KV, ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KV
+            );
+        }
+    }
+
+    void memoryDestroy()
+    {
+        if (_arrayLength == 0)
+        {
+            return;
+        }
+
+        SortSequential::memoryDestroy();
+
+        free(_h_keysBuffer);
+        free(_h_valuesBuffer);
+        free(_h_valuesPivot);
+        _h_valuesBuffer = NULL;
+        _h_valuesPivot = NULL;
+        _valuesBufferLength = 0;
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Sets the number of host threads used for sort.
+    */
+    void setNumThreads(uint_t numThreads)
+    {
+        _numThreads = numThreads > 0 ? numThreads : 1;
+    }
+};
+
+#endif
@@ -8,6 +8,8 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../constants.h"
+#include "../partition_simd.h"
 
 
 /*
@@ -29,14 +31,19 @@ protected:
     }
 
     /*
-    Searches for pivot - searches for median of first, middle and last element in array.
+    Returns true, if element "elem1" can be located before element "elem2" in sorted array.
     */
-    uint_t getPivotIndex(data_t *h_keys, uint_t arrayLength)
+    template <order_t sortOrder>
+    bool isOrdered(data_t elem1, data_t elem2)
     {
-        uint_t index1 = 0;
-        uint_t index2 = arrayLength / 2;
-        uint_t index3 = arrayLength - 1;
+        return sortOrder == ORDER_ASC ? elem1 <= elem2 : elem1 >= elem2;
+    }
 
+    /*
+    Returns the index of median of elements on provided indexes.
+    */
+    uint_t getMedianIndex(data_t *h_keys, uint_t index1, uint_t index2, uint_t index3)
+    {
         if (h_keys[index1] > h_keys[index2])
         {
             if (h_keys[index2] > h_keys[index3])
@@ -70,12 +77,33 @@ protected:
     }
 
     /*
-    Partitions keys into 2 partitions - elements lower and elements greater than pivot.
+    Searches for pivot - for short arrays searches for median of first, middle and last element in array. For
+    long arrays searches for median of medians of 9 elements (Tukey's ninther).
+    */
+    uint_t getPivotIndex(data_t *h_keys, uint_t arrayLength)
+    {
+        uint_t indexMiddle = arrayLength / 2;
+        uint_t indexLast = arrayLength - 1;
+
+        if (arrayLength <= THRESHOLD_NINTHER_SEQUENTIAL)
+        {
+            return getMedianIndex(h_keys, 0, indexMiddle, indexLast);
+        }
+
+        uint_t step = arrayLength / 8;
+        uint_t median1 = getMedianIndex(h_keys, 0, step, 2 * step);
+        uint_t median2 = getMedianIndex(h_keys, indexMiddle - step, indexMiddle, indexMiddle + step);
+        uint_t median3 = getMedianIndex(h_keys, indexLast - 2 * step, indexLast - step, indexLast);
+
+        return getMedianIndex(h_keys, median1, median2, median3);
+    }
+
+    /*
+    Partitions keys into 2 partitions - elements lower and elements greater or equal than pivot.
     */
     template <order_t sortOrder>
-    uint_t partitionArray(data_t *h_keys, uint_t arrayLength)
+    uint_t partitionArray(data_t *h_keys, uint_t arrayLength, uint_t pivotIndex)
     {
-        uint_t pivotIndex = getPivotIndex(h_keys, arrayLength);
         data_t pivotValue = h_keys[pivotIndex];
 
         exchangeElemens(&h_keys[pivotIndex], &h_keys[arrayLength - 1]);
@@ -83,7 +111,7 @@ protected:
 
         for (uint_t i = 0; i < arrayLength - 1; i++)
         {
-            if (sortOrder ^ (h_keys[i] <= pivotValue))
+            if (!isOrdered<sortOrder>(pivotValue, h_keys[i]))
             {
                 exchangeElemens(&h_keys[i], &h_keys[storeIndex]);
                 storeIndex++;
@@ -95,12 +123,11 @@ protected:
     }
 
     /*
-    Partitions keys and values into 2 partitions - elements lower and elements greater than pivot.
+    Partitions keys and values into 2 partitions - elements lower and elements greater or equal than pivot.
     */
     template <order_t sortOrder>
-    uint_t partitionArray(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    uint_t partitionArray(data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t pivotIndex)
     {
-        uint_t pivotIndex = getPivotIndex(h_keys, arrayLength);
         data_t pivotValue = h_keys[pivotIndex];
 
         exchangeElemens(&h_keys[pivotIndex], &h_keys[arrayLength - 1]);
@@ -109,7 +136,7 @@ protected:
 
         for (uint_t i = 0; i < arrayLength - 1; i++)
         {
-            if (sortOrder ^ (h_keys[i] <= pivotValue))
+            if (!isOrdered<sortOrder>(pivotValue, h_keys[i]))
             {
                 exchangeElemens(&h_keys[i], &h_keys[storeIndex]);
                 exchangeElemens(&h_values[i], &h_values[storeIndex]);
@@ -123,52 +150,521 @@ protected:
     }
 
     /*
-    Sorts keys only with quicksort.
+    Partitions keys (and values) into 2 partitions - elements lower and elements greater or equal than pivot
+    value - with block partitioning (BlockQuicksort). Elements, which belong to the other side of array, are
+    searched for in blocks on both sides of array. Their offsets are stored to buffers without branches (see
+    "classifyLeft()" and "classifyRight()") and after that the found elements are exchanged. Returns the length
+    of lower partition.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    uint_t partitionBlock(data_t *h_keys, data_t *h_values, uint_t arrayLength, data_t pivotValue)
+    {
+        const uint_t blockSize = BLOCK_SIZE_PARTITION_SEQUENTIAL;
+        uint_t offsetsLeft[blockSize], offsetsRight[blockSize];
+        uint_t numLeft = 0, numRight = 0, startLeft = 0, startRight = 0;
+
+        // Elements in [0, left) are lower and elements in [right, arrayLength) are greater or equal than pivot
+        uint_t left = 0, right = arrayLength;
+
+        while (true)
+        {
+            uint_t lengthLeft = blockSize, lengthRight = blockSize;
+            bool isLastBlock = right - left <= 2 * blockSize;
+
+            // Last blocks contain the rest of elements, which haven't been classified yet
+            if (isLastBlock)
+            {
+                uint_t lengthUnknown = right - left - (numLeft || numRight ? blockSize : 0);
+
+                if (numRight > 0)
+                {
+                    lengthLeft = lengthUnknown;
+                }
+                else if (numLeft > 0)
+                {
+                    lengthRight = lengthUnknown;
+                }
+                else
+                {
+                    lengthLeft = lengthUnknown / 2;
+                    lengthRight = lengthUnknown - lengthLeft;
+                }
+            }
+
+            if (numLeft == 0)
+            {
+                startLeft = 0;
+                numLeft = isLastBlock
+                    ? classifyLeftScalar<sortOrder>(h_keys + left, lengthLeft, pivotValue, offsetsLeft)
+                    : classifyLeft<sortOrder>(h_keys + left, lengthLeft, pivotValue, offsetsLeft);
+            }
+            if (numRight == 0)
+            {
+                startRight = 0;
+                numRight = isLastBlock
+                    ? classifyRightScalar<sortOrder>(h_keys + right, lengthRight, pivotValue, offsetsRight)
+                    : classifyRight<sortOrder>(h_keys + right, lengthRight, pivotValue, offsetsRight);
+            }
+
+            uint_t numExchanges = min(numLeft, numRight);
+            for (uint_t i = 0; i < numExchanges; i++)
+            {
+                uint_t indexLeft = left + offsetsLeft[startLeft + i];
+                uint_t indexRight = right - offsetsRight[startRight + i];
+
+                exchangeElemens(&h_keys[indexLeft], &h_keys[indexRight]);
+                if (!sortingKeyOnly)
+                {
+                    exchangeElemens(&h_values[indexLeft], &h_values[indexRight]);
+                }
+            }
+
+            numLeft -= numExchanges;
+            numRight -= numExchanges;
+            startLeft += numExchanges;
+            startRight += numExchanges;
+
+            if (numLeft == 0)
+            {
+                left += lengthLeft;
+            }
+            if (numRight == 0)
+            {
+                right -= lengthRight;
+            }
+
+            if (isLastBlock)
+            {
+                break;
+            }
+        }
+
+        // Elements, which remained in one of the blocks, are moved to the edge of block
+        if (numLeft > 0)
+        {
+            for (; numLeft > 0; numLeft--)
+            {
+                uint_t index = left + offsetsLeft[startLeft + numLeft - 1];
+                right--;
+
+                exchangeElemens(&h_keys[index], &h_keys[right]);
+                if (!sortingKeyOnly)
+                {
+                    exchangeElemens(&h_values[index], &h_values[right]);
+                }
+            }
+
+            left = right;
+        }
+        for (; numRight > 0; numRight--)
+        {
+            uint_t index = right - offsetsRight[startRight + numRight - 1];
+
+            exchangeElemens(&h_keys[index], &h_keys[left]);
+            if (!sortingKeyOnly)
+            {
+                exchangeElemens(&h_values[index], &h_values[left]);
+            }
+            left++;
+        }
+
+        return left;
+    }
+
+    /*
+    Partitions keys (and values) into 2 partitions - elements lower and elements greater or equal than pivot -
+    with block partitioning. Returns the index of pivot.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    uint_t partitionArrayBlock(data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t pivotIndex)
+    {
+        exchangeElemens(&h_keys[0], &h_keys[pivotIndex]);
+        if (!sortingKeyOnly)
+        {
+            exchangeElemens(&h_values[0], &h_values[pivotIndex]);
+        }
+
+        uint_t lowerLength = partitionBlock<sortOrder, sortingKeyOnly>(
+            h_keys + 1, sortingKeyOnly ? NULL : h_values + 1, arrayLength - 1, h_keys[0]
+        );
+
+        // Pivot is moved between partitions
+        exchangeElemens(&h_keys[0], &h_keys[lowerLength]);
+        if (!sortingKeyOnly)
+        {
+            exchangeElemens(&h_values[0], &h_values[lowerLength]);
+        }
+
+        return lowerLength;
+    }
+
+    /*
+    Exchanges blocks of elements of provided length, which start on indexes "index1" and "index2".
+    */
+    void exchangeBlocks(data_t *h_array, uint_t index1, uint_t index2, uint_t length)
+    {
+        for (uint_t i = 0; i < length; i++)
+        {
+            exchangeElemens(&h_array[index1 + i], &h_array[index2 + i]);
+        }
+    }
+
+    /*
+    Partitions keys into 3 partitions - elements lower, equal and greater than pivot (Bentley-McIlroy).
+    Elements equal to pivot are first exchanged to the edges of array and after partitioning to the middle of
+    array. Returns the length of lower partition (located at the start of array) and the length of greater
+    partition (located at the end of array).
     */
     template <order_t sortOrder>
-    void quicksortSequential(data_t *h_keys, uint_t arrayLength)
+    void partitionArrayThreeWay(
+        data_t *h_keys, uint_t arrayLength, uint_t pivotIndex, uint_t &lowerLength, uint_t &greaterLength
+    )
     {
-        if (arrayLength <= 1)
+        data_t pivotValue = h_keys[pivotIndex];
+
+        // Equal elements are stored in [0, equalLowerEnd) and [equalGreaterStart, arrayLength)
+        uint_t equalLowerEnd = 0, equalGreaterStart = arrayLength;
+        // Indexes of next element from the left and (exclusive) next element from the right
+        uint_t left = 0, right = arrayLength;
+
+        while (true)
         {
-            return;
+            while (left < right && isOrdered<sortOrder>(h_keys[left], pivotValue))
+            {
+                if (h_keys[left] == pivotValue)
+                {
+                    exchangeElemens(&h_keys[equalLowerEnd], &h_keys[left]);
+                    equalLowerEnd++;
+                }
+                left++;
+            }
+            while (left < right && isOrdered<sortOrder>(pivotValue, h_keys[right - 1]))
+            {
+                if (h_keys[right - 1] == pivotValue)
+                {
+                    equalGreaterStart--;
+                    exchangeElemens(&h_keys[equalGreaterStart], &h_keys[right - 1]);
+                }
+                right--;
+            }
+
+            if (left >= right)
+            {
+                break;
+            }
+
+            right--;
+            exchangeElemens(&h_keys[left], &h_keys[right]);
+            left++;
+        }
+
+        lowerLength = left - equalLowerEnd;
+        greaterLength = equalGreaterStart - right;
+
+        // Moves equal elements from the edges of array to the middle
+        uint_t length = min(equalLowerEnd, lowerLength);
+        exchangeBlocks(h_keys, 0, left - length, length);
+        length = min(arrayLength - equalGreaterStart, greaterLength);
+        exchangeBlocks(h_keys, right, arrayLength - length, length);
+    }
+
+    /*
+    Partitions keys and values into 3 partitions - elements lower, equal and greater than pivot (Bentley-McIlroy).
+    Elements equal to pivot are first exchanged to the edges of array and after partitioning to the middle of
+    array. Returns the length of lower partition (located at the start of array) and the length of greater
+    partition (located at the end of array).
+    */
+    template <order_t sortOrder>
+    void partitionArrayThreeWay(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t pivotIndex, uint_t &lowerLength,
+        uint_t &greaterLength
+    )
+    {
+        data_t pivotValue = h_keys[pivotIndex];
+
+        // Equal elements are stored in [0, equalLowerEnd) and [equalGreaterStart, arrayLength)
+        uint_t equalLowerEnd = 0, equalGreaterStart = arrayLength;
+        // Indexes of next element from the left and (exclusive) next element from the right
+        uint_t left = 0, right = arrayLength;
+
+        while (true)
+        {
+            while (left < right && isOrdered<sortOrder>(h_keys[left], pivotValue))
+            {
+                if (h_keys[left] == pivotValue)
+                {
+                    exchangeElemens(&h_keys[equalLowerEnd], &h_keys[left]);
+                    exchangeElemens(&h_values[equalLowerEnd], &h_values[left]);
+                    equalLowerEnd++;
+                }
+                left++;
+            }
+            while (left < right && isOrdered<sortOrder>(pivotValue, h_keys[right - 1]))
+            {
+                if (h_keys[right - 1] == pivotValue)
+                {
+                    equalGreaterStart--;
+                    exchangeElemens(&h_keys[equalGreaterStart], &h_keys[right - 1]);
+                    exchangeElemens(&h_values[equalGreaterStart], &h_values[right - 1]);
+                }
+                right--;
+            }
+
+            if (left >= right)
+            {
+                break;
+            }
+
+            right--;
+            exchangeElemens(&h_keys[left], &h_keys[right]);
+            exchangeElemens(&h_values[left], &h_values[right]);
+            left++;
+        }
+
+        lowerLength = left - equalLowerEnd;
+        greaterLength = equalGreaterStart - right;
+
+        // Moves equal elements from the edges of array to the middle
+        uint_t length = min(equalLowerEnd, lowerLength);
+        exchangeBlocks(h_keys, 0, left - length, length);
+        exchangeBlocks(h_values, 0, left - length, length);
+        length = min(arrayLength - equalGreaterStart, greaterLength);
+        exchangeBlocks(h_keys, right, arrayLength - length, length);
+        exchangeBlocks(h_values, right, arrayLength - length, length);
+    }
+
+    /*
+    Returns the max recursion depth of quicksort for array of provided length. When it is exceeded, partition
+    is sorted with heapsort, which limits the worst case time to O(n * log(n)).
+    */
+    uint_t getDepthLimit(uint_t arrayLength)
+    {
+        uint_t depthLimit = 0;
+
+        for (; arrayLength > 1; arrayLength /= 2)
+        {
+            depthLimit += DEPTH_LIMIT_FACTOR_SEQUENTIAL;
+        }
+
+        return depthLimit;
+    }
+
+    /*
+    Sorts data with insertion sort. Used for short partitions.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void insertionSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        for (uint_t i = 1; i < arrayLength; i++)
+        {
+            data_t key = h_keys[i];
+            data_t value = sortingKeyOnly ? 0 : h_values[i];
+            uint_t j = i;
+
+            for (; j > 0 && !isOrdered<sortOrder>(h_keys[j - 1], key); j--)
+            {
+                h_keys[j] = h_keys[j - 1];
+                if (!sortingKeyOnly)
+                {
+                    h_values[j] = h_values[j - 1];
+                }
+            }
+
+            h_keys[j] = key;
+            if (!sortingKeyOnly)
+            {
+                h_values[j] = value;
+            }
+        }
+    }
+
+    /*
+    Moves the element on provided index down the heap, until it is located after both of its children.
+    Heap contains elements, which are located last in sorted array, on the top.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void siftDown(data_t *h_keys, data_t *h_values, uint_t index, uint_t heapLength)
+    {
+        data_t key = h_keys[index];
+        data_t value = sortingKeyOnly ? 0 : h_values[index];
+
+        for (uint64_t child = 2 * (uint64_t)index + 1; child < heapLength; child = 2 * (uint64_t)index + 1)
+        {
+            if (child + 1 < heapLength && !isOrdered<sortOrder>(h_keys[child + 1], h_keys[child]))
+            {
+                child++;
+            }
+            if (isOrdered<sortOrder>(h_keys[child], key))
+            {
+                break;
+            }
+
+            h_keys[index] = h_keys[child];
+            if (!sortingKeyOnly)
+            {
+                h_values[index] = h_values[child];
+            }
+            index = (uint_t)child;
+        }
+
+        h_keys[index] = key;
+        if (!sortingKeyOnly)
+        {
+            h_values[index] = value;
+        }
+    }
+
+    /*
+    Sorts data with heapsort. Used for partitions, which exceeded the recursion depth limit.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void heapSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        for (uint_t i = arrayLength / 2; i > 0; i--)
+        {
+            siftDown<sortOrder, sortingKeyOnly>(h_keys, h_values, i - 1, arrayLength);
         }
-        else if (arrayLength == 2)
+
+        for (uint_t heapLength = arrayLength - 1; heapLength > 0; heapLength--)
         {
-            if (sortOrder ^ (h_keys[0] > h_keys[1]))
+            exchangeElemens(&h_keys[0], &h_keys[heapLength]);
+            if (!sortingKeyOnly)
             {
-                exchangeElemens(&h_keys[0], &h_keys[1]);
+                exchangeElemens(&h_values[0], &h_values[heapLength]);
+            }
+            siftDown<sortOrder, sortingKeyOnly>(h_keys, h_values, 0, heapLength);
+        }
+    }
+
+    /*
+    Partitions keys (and values) with pivot chosen from array. Returns the length of lower partition (located at
+    the start of array) and the length of greater partition (located at the end of array). Elements between them
+    are already sorted. If partition isn't leftmost, element before it is lower or equal than all its elements.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void partitionStep(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, bool isLeftmost, uint_t &lowerLength,
+        uint_t &greaterLength
+    )
+    {
+        uint_t pivotIndex = getPivotIndex(h_keys, arrayLength);
+
+        // All elements are greater or equal than element before partition. If pivot is equal to it, partition
+        // contains many duplicates, which are excluded from further sorting with three-way partition.
+        bool isPivotRepeated = !isLeftmost && isOrdered<sortOrder>(h_keys[pivotIndex], h_keys[-1]);
+
+        if (USE_THREE_WAY_PARTITION_SEQUENTIAL && isPivotRepeated)
+        {
+            if (sortingKeyOnly)
+            {
+                partitionArrayThreeWay<sortOrder>(h_keys, arrayLength, pivotIndex, lowerLength, greaterLength);
+            }
+            else
+            {
+                partitionArrayThreeWay<sortOrder>(
+                    h_keys, h_values, arrayLength, pivotIndex, lowerLength, greaterLength
+                );
             }
             return;
         }
 
-        uint_t partition = partitionArray<sortOrder>(h_keys, arrayLength);
-        quicksortSequential<sortOrder>(h_keys, partition);
-        quicksortSequential<sortOrder>(h_keys + partition + 1, arrayLength - partition - 1);
+        if (USE_BLOCK_PARTITION_SEQUENTIAL)
+        {
+            lowerLength = partitionArrayBlock<sortOrder, sortingKeyOnly>(h_keys, h_values, arrayLength, pivotIndex);
+        }
+        else if (sortingKeyOnly)
+        {
+            lowerLength = partitionArray<sortOrder>(h_keys, arrayLength, pivotIndex);
+        }
+        else
+        {
+            lowerLength = partitionArray<sortOrder>(h_keys, h_values, arrayLength, pivotIndex);
+        }
+        greaterLength = arrayLength - lowerLength - 1;
     }
 
     /*
-    Sorts key-value pairs with quicksort.
+    Sorts keys only with introspective quicksort. Smaller partition is sorted recursively and greater partition
+    in loop, which limits recursion depth to log2(n). When depth limit is exceeded, partition is sorted with
+    heapsort. Short partitions are sorted with insertion sort.
+    If partition isn't leftmost, element before it is lower or equal than all its elements.
     */
     template <order_t sortOrder>
-    void quicksortSequential(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    void quicksortSequential(data_t *h_keys, uint_t arrayLength, uint_t depthLimit, bool isLeftmost)
     {
-        if (arrayLength <= 1)
+        while (arrayLength > THRESHOLD_INSERTION_SORT_SEQUENTIAL_KO)
         {
-            return;
+            if (depthLimit == 0)
+            {
+                heapSort<sortOrder, true>(h_keys, NULL, arrayLength);
+                return;
+            }
+            depthLimit--;
+
+            uint_t lowerLength, greaterLength;
+            partitionStep<sortOrder, true>(h_keys, NULL, arrayLength, isLeftmost, lowerLength, greaterLength);
+
+            if (lowerLength < greaterLength)
+            {
+                quicksortSequential<sortOrder>(h_keys, lowerLength, depthLimit, isLeftmost);
+                h_keys += arrayLength - greaterLength;
+                arrayLength = greaterLength;
+            }
+            else
+            {
+                quicksortSequential<sortOrder>(
+                    h_keys + arrayLength - greaterLength, greaterLength, depthLimit, false
+                );
+                arrayLength = lowerLength;
+            }
+            isLeftmost = isLeftmost && lowerLength >= greaterLength;
         }
-        else if (arrayLength == 2)
+
+        insertionSort<sortOrder, true>(h_keys, NULL, arrayLength);
+    }
+
+    /*
+    Sorts key-value pairs with introspective quicksort. Smaller partition is sorted recursively and greater
+    partition in loop, which limits recursion depth to log2(n). When depth limit is exceeded, partition is sorted
+    with heapsort. Short partitions are sorted with insertion sort.
+    If partition isn't leftmost, element before it is lower or equal than all its elements.
+    */
+    template <order_t sortOrder>
+    void quicksortSequential(
+        data_t *h_keys, data_t *h_values, uint_t arrayLength, uint_t depthLimit, bool isLeftmost
+    )
+    {
+        while (arrayLength > THRESHOLD_INSERTION_SORT_SEQUENTIAL_KV)
         {
-            if (sortOrder ^ (h_keys[0] > h_keys[1]))
+            if (depthLimit == 0)
             {
-                exchangeElemens(&h_keys[0], &h_keys[1]);
-                exchangeElemens(&h_values[0], &h_values[1]);
+                heapSort<sortOrder, false>(h_keys, h_values, arrayLength);
+                return;
             }
-            return;
+            depthLimit--;
+
+            uint_t lowerLength, greaterLength;
+            partitionStep<sortOrder, false>(h_keys, h_values, arrayLength, isLeftmost, lowerLength, greaterLength);
+
+            if (lowerLength < greaterLength)
+            {
+                quicksortSequential<sortOrder>(h_keys, h_values, lowerLength, depthLimit, isLeftmost);
+                h_keys += arrayLength - greaterLength;
+                h_values += arrayLength - greaterLength;
+                arrayLength = greaterLength;
+            }
+            else
+            {
+                quicksortSequential<sortOrder>(
+                    h_keys + arrayLength - greaterLength, h_values + arrayLength - greaterLength, greaterLength,
+                    depthLimit, false
+                );
+                arrayLength = lowerLength;
+            }
+            isLeftmost = isLeftmost && lowerLength >= greaterLength;
         }
 
-        uint_t partition = partitionArray<sortOrder>(h_keys, h_values, arrayLength);
-        quicksortSequential<sortOrder>(h_keys, h_values, partition);
-        quicksortSequential<sortOrder>(h_keys + partition + 1, h_values + partition + 1, arrayLength - partition - 1);
+        insertionSort<sortOrder, false>(h_keys, h_values, arrayLength);
     }
 
     /*
@@ -179,11 +675,11 @@ protected:
     {
         if (_sortOrder == ORDER_ASC)
         {
-            quicksortSequential<ORDER_ASC>(_h_keys, _arrayLength);
+            quicksortSequential<ORDER_ASC>(_h_keys, _arrayLength, getDepthLimit(_arrayLength), true);
         }
         else
         {
-            quicksortSequential<ORDER_DESC>(_h_keys, _arrayLength);
+            quicksortSequential<ORDER_DESC>(_h_keys, _arrayLength, getDepthLimit(_arrayLength), true);
         }
     }
 
@@ -195,11 +691,11 @@ protected:
     {
         if (_sortOrder == ORDER_ASC)
         {
-            quicksortSequential<ORDER_ASC>(_h_keys, _h_values, _arrayLength);
+            quicksortSequential<ORDER_ASC>(_h_keys, _h_values, _arrayLength, getDepthLimit(_arrayLength), true);
         }
         else
         {
-            quicksortSequential<ORDER_DESC>(_h_keys, _h_values, _arrayLength);
+            quicksortSequential<ORDER_DESC>(_h_keys, _h_values, _arrayLength, getDepthLimit(_arrayLength), true);
         }
     }
 
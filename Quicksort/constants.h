@@ -16,6 +16,78 @@ _KV: Key-value
 // - VAL 1: min/max reduction is performed in order to find MAX value of newly generated LOWER sequence
 //          and MIN value of newly generated GREATER sequence (SLOWER, but ALWAYS correct min/max value)
 #define USE_REDUCTION_IN_GLOBAL_SORT 0
+// For SEQUENTIAL quicksort it designates whether:
+// - VAL 0: keys are always partitioned into 2 partitions - elements lower and elements greater or equal than PIVOT
+// - VAL 1: if PIVOT is equal to PIVOT of parent partition, keys are partitioned into 3 partitions - elements
+//          lower, equal and greater than PIVOT. Elements equal to PIVOT aren't sorted anymore (FASTER for arrays
+//          with many duplicates)
+#define USE_THREE_WAY_PARTITION_SEQUENTIAL 1
+// For SEQUENTIAL quicksort it designates whether:
+// - VAL 0: keys are partitioned by exchanging elements one by one (SLOWER because of branch mispredictions)
+// - VAL 1: keys are partitioned in blocks - elements are classified without branches into offset buffers (with
+//          AVX2/AVX-512 if supported by host) and then exchanged (FASTER)
+#define USE_BLOCK_PARTITION_SEQUENTIAL 1
+
+
+/* -------------- SEQUENTIAL QUICKSORT -------------- */
+
+// Threshold for partition length, when insertion sort is used instead of quicksort.
+#if DATA_TYPE_BITS == 32
+#define THRESHOLD_INSERTION_SORT_SEQUENTIAL_KO 16
+#define THRESHOLD_INSERTION_SORT_SEQUENTIAL_KV 16
+#else
+#define THRESHOLD_INSERTION_SORT_SEQUENTIAL_KO 16
+#define THRESHOLD_INSERTION_SORT_SEQUENTIAL_KV 16
+#endif
+// Length of blocks in block partitioning. Has to be divisible by 16.
+#define BLOCK_SIZE_PARTITION_SEQUENTIAL 128
+// Threshold for partition length, when median of 9 elements (instead of 3) is used as pivot.
+#define THRESHOLD_NINTHER_SEQUENTIAL 128
+// Max recursion depth is "DEPTH_LIMIT_FACTOR_SEQUENTIAL * log2(arrayLength)". When it is exceeded, heapsort is used.
+#define DEPTH_LIMIT_FACTOR_SEQUENTIAL 2
+
+
+/* ------------ MULTITHREADED QUICKSORT ------------- */
+
+// How many host threads are used. If 0, the number of concurrent threads supported by host is used.
+#define NUM_THREADS_MULTITHREADED_QUICKSORT 0
+// Minimum number of elements partitioned by one thread, when sequence is partitioned cooperatively by all threads.
+#if DATA_TYPE_BITS == 32
+#define MIN_ELEMS_PER_THREAD_COOPERATIVE_KO (1 << 16)
+#define MIN_ELEMS_PER_THREAD_COOPERATIVE_KV (1 << 15)
+#else
+#define MIN_ELEMS_PER_THREAD_COOPERATIVE_KO (1 << 15)
+#define MIN_ELEMS_PER_THREAD_COOPERATIVE_KV (1 << 15)
+#endif
+// Sequences shorter or equal than grain size are sorted by one thread without creating new tasks for other threads.
+#if DATA_TYPE_BITS == 32
+#define GRAIN_SIZE_MULTITHREADED_KO (1 << 14)
+#define GRAIN_SIZE_MULTITHREADED_KV (1 << 13)
+#else
+#define GRAIN_SIZE_MULTITHREADED_KO (1 << 13)
+#define GRAIN_SIZE_MULTITHREADED_KV (1 << 13)
+#endif
+
+
+/* -------- MULTITHREADED GLOBAL/LOCAL QUICKSORT -------- */
+
+// Threshold size until sequence is still partitioned cooperatively by multiple groups of elements (counterpart of
+// thread blocks in GLOBAL quicksort). Shorter sequences are sorted by one thread (counterpart of LOCAL quicksort).
+#if DATA_TYPE_BITS == 32
+#define THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KO (1 << 15)
+#define THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KV (1 << 14)
+#else
+#define THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KO (1 << 14)
+#define THRESHOLD_PARTITION_SIZE_GLOBAL_MULTITHREADED_KV (1 << 14)
+#endif
+// How many elements are processed by each group in global step. Groups are distributed dynamically among threads.
+#if DATA_TYPE_BITS == 32
+#define ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KO (1 << 13)
+#define ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KV (1 << 12)
+#else
+#define ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KO (1 << 12)
+#define ELEMS_PER_GROUP_GLOBAL_MULTITHREADED_KV (1 << 12)
+#endif
 
 
 /* ---------------- MIN/MAX REDUCTION --------------- */
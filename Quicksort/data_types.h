@@ -10,6 +10,7 @@
 typedef struct HostGlobalSequence h_glob_seq_t;
 typedef struct DeviceGlobalSequence d_glob_seq_t;
 typedef struct LocalSequence loc_seq_t;
+typedef struct ThreadSequence thr_seq_t;
 typedef enum TransferDirection direct_t;
 
 
@@ -95,4 +96,18 @@ struct LocalSequence
     void setGreaterSeq(h_glob_seq_t globalSeqHost, d_glob_seq_t globalSeqDev);
 };
 
+/*
+Params for sequence sorted by host threads in MULTITHREADED quicksort.
+*/
+struct ThreadSequence
+{
+    uint_t start;
+    uint_t length;
+    // Remaining recursion depth, after which sequence is sorted with heapsort
+    uint_t depthLimit;
+    // Denotes if sequence is located at the start of array. Otherwise element before sequence is lower or equal
+    // than all its elements.
+    bool isLeftmost;
+};
+
 #endif
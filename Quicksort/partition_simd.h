@@ -0,0 +1,268 @@
+#ifndef PARTITION_SIMD_QUICKSORT_H
+#define PARTITION_SIMD_QUICKSORT_H
+
+#include "../Utils/data_types_common.h"
+#include "../Utils/host.h"
+#include "../Utils/simd.h"
+
+
+/*
+Kernels for classification of blocks in block partitioning (BlockQuicksort). Block on the left side of array is
+searched for elements, which belong to the right side (not located before pivot in sorted array) and block on the
+right side of array is searched for elements, which belong to the left side. Offsets of found elements are stored
+to buffer without branches. Offsets of left block are relative to start of block, offsets of right block are
+relative to end of block (element is located on index "blockEnd - offset").
+Both buffers contain offsets in ascending order.
+*/
+
+/*
+Classifies left block of provided length with scalar code. Returns the number of stored offsets.
+*/
+template <order_t sortOrder>
+inline uint_t classifyLeftScalar(data_t *keys, uint_t length, data_t pivot, uint_t *offsets)
+{
+    uint_t numOffsets = 0;
+
+    for (uint_t i = 0; i < length; i++)
+    {
+        offsets[numOffsets] = i;
+        numOffsets += sortOrder == ORDER_ASC ? keys[i] >= pivot : keys[i] <= pivot;
+    }
+
+    return numOffsets;
+}
+
+/*
+Classifies right block of provided length, which ends on "keysEnd", with scalar code. Returns the number of stored
+offsets.
+*/
+template <order_t sortOrder>
+inline uint_t classifyRightScalar(data_t *keysEnd, uint_t length, data_t pivot, uint_t *offsets)
+{
+    uint_t numOffsets = 0;
+
+    for (uint_t i = 1; i <= length; i++)
+    {
+        offsets[numOffsets] = i;
+        numOffsets += sortOrder == ORDER_ASC ? *(keysEnd - i) < pivot : *(keysEnd - i) > pivot;
+    }
+
+    return numOffsets;
+}
+
+#if DATA_TYPE_BITS == 32
+
+/*
+Table of permutations for AVX2 compress. For every 8-bit mask it contains indexes of lanes with set bits, which are
+moved to the beginning of vector.
+*/
+struct CompressTableAvx2
+{
+    uint_t permutations[256][8];
+
+    CompressTableAvx2()
+    {
+        for (uint_t mask = 0; mask < 256; mask++)
+        {
+            uint_t numLanes = 0;
+
+            for (uint_t lane = 0; lane < 8; lane++)
+            {
+                permutations[mask][lane] = 0;
+            }
+            for (uint_t lane = 0; lane < 8; lane++)
+            {
+                if (mask & (1 << lane))
+                {
+                    permutations[mask][numLanes++] = lane;
+                }
+            }
+        }
+    }
+};
+
+/*
+Stores lanes of "offsetsVector" with set bits in mask to buffer. Writes whole vector, so buffer has to contain at
+least 8 elements after "offsets".
+*/
+TARGET_AVX2 inline uint_t compressStoreAvx2(__m256i offsetsVector, uint_t mask, uint_t *offsets)
+{
+    static const CompressTableAvx2 table;
+
+    __m256i permutation = _mm256_loadu_si256((__m256i*)table.permutations[mask]);
+    _mm256_storeu_si256((__m256i*)offsets, _mm256_permutevar8x32_epi32(offsetsVector, permutation));
+
+    return _mm_popcnt_u32(mask);
+}
+
+/*
+Returns the mask of 8 keys, which are not located before pivot (left block) or are located before pivot (right
+block) in sorted array.
+*/
+template <order_t sortOrder, bool isLeftBlock>
+TARGET_AVX2 inline uint_t getClassifyMaskAvx2(__m256i keys, __m256i pivot)
+{
+    // Unsigned comparison isn't supported, so "keys >= pivot" is computed as "max(keys, pivot) == keys"
+    __m256i bound = sortOrder == ORDER_ASC ? _mm256_max_epu32(keys, pivot) : _mm256_min_epu32(keys, pivot);
+    uint_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bound, keys)));
+
+    return isLeftBlock ? mask : mask ^ 0xFF;
+}
+
+/*
+Classifies left block of length divisible by 8 with AVX2.
+*/
+template <order_t sortOrder>
+TARGET_AVX2 uint_t classifyLeftAvx2(data_t *keys, uint_t length, data_t pivot, uint_t *offsets)
+{
+    const uint_t vectorLen = 8;
+    __m256i pivotVector = _mm256_set1_epi32(pivot);
+    __m256i offsetsVector = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i offsetsIncrement = _mm256_set1_epi32(vectorLen);
+    uint_t numOffsets = 0;
+
+    for (uint_t i = 0; i < length; i += vectorLen)
+    {
+        __m256i keysVector = _mm256_loadu_si256((__m256i*)(keys + i));
+        uint_t mask = getClassifyMaskAvx2<sortOrder, true>(keysVector, pivotVector);
+
+        numOffsets += compressStoreAvx2(offsetsVector, mask, offsets + numOffsets);
+        offsetsVector = _mm256_add_epi32(offsetsVector, offsetsIncrement);
+    }
+
+    return numOffsets;
+}
+
+/*
+Classifies right block of length divisible by 8, which ends on "keysEnd", with AVX2. Keys are reversed, so that
+offsets are stored in ascending order.
+*/
+template <order_t sortOrder>
+TARGET_AVX2 uint_t classifyRightAvx2(data_t *keysEnd, uint_t length, data_t pivot, uint_t *offsets)
+{
+    const uint_t vectorLen = 8;
+    __m256i pivotVector = _mm256_set1_epi32(pivot);
+    __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i offsetsVector = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8);
+    __m256i offsetsIncrement = _mm256_set1_epi32(vectorLen);
+    uint_t numOffsets = 0;
+
+    for (uint_t i = vectorLen; i <= length; i += vectorLen)
+    {
+        __m256i keysVector = _mm256_loadu_si256((__m256i*)(keysEnd - i));
+        keysVector = _mm256_permutevar8x32_epi32(keysVector, reverse);
+        uint_t mask = getClassifyMaskAvx2<sortOrder, false>(keysVector, pivotVector);
+
+        numOffsets += compressStoreAvx2(offsetsVector, mask, offsets + numOffsets);
+        offsetsVector = _mm256_add_epi32(offsetsVector, offsetsIncrement);
+    }
+
+    return numOffsets;
+}
+
+/*
+Classifies left block of length divisible by 16 with AVX-512 compress-store.
+*/
+template <order_t sortOrder>
+TARGET_AVX512 uint_t classifyLeftAvx512(data_t *keys, uint_t length, data_t pivot, uint_t *offsets)
+{
+    const uint_t vectorLen = 16;
+    __m512i pivotVector = _mm512_set1_epi32(pivot);
+    __m512i offsetsVector = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i offsetsIncrement = _mm512_set1_epi32(vectorLen);
+    uint_t numOffsets = 0;
+
+    for (uint_t i = 0; i < length; i += vectorLen)
+    {
+        __m512i keysVector = _mm512_loadu_si512(keys + i);
+        __mmask16 mask = _mm512_cmp_epu32_mask(
+            keysVector, pivotVector, sortOrder == ORDER_ASC ? _MM_CMPINT_NLT : _MM_CMPINT_LE
+        );
+
+        _mm512_mask_compressstoreu_epi32(offsets + numOffsets, mask, offsetsVector);
+        numOffsets += _mm_popcnt_u32(mask);
+        offsetsVector = _mm512_add_epi32(offsetsVector, offsetsIncrement);
+    }
+
+    return numOffsets;
+}
+
+/*
+Classifies right block of length divisible by 16, which ends on "keysEnd", with AVX-512 compress-store. Keys are
+reversed, so that offsets are stored in ascending order.
+*/
+template <order_t sortOrder>
+TARGET_AVX512 uint_t classifyRightAvx512(data_t *keysEnd, uint_t length, data_t pivot, uint_t *offsets)
+{
+    const uint_t vectorLen = 16;
+    __m512i pivotVector = _mm512_set1_epi32(pivot);
+    __m512i reverse = _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    __m512i offsetsVector = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    __m512i offsetsIncrement = _mm512_set1_epi32(vectorLen);
+    uint_t numOffsets = 0;
+
+    for (uint_t i = vectorLen; i <= length; i += vectorLen)
+    {
+        __m512i keysVector = _mm512_permutexvar_epi32(reverse, _mm512_loadu_si512(keysEnd - i));
+        __mmask16 mask = _mm512_cmp_epu32_mask(
+            keysVector, pivotVector, sortOrder == ORDER_ASC ? _MM_CMPINT_LT : _MM_CMPINT_NLE
+        );
+
+        _mm512_mask_compressstoreu_epi32(offsets + numOffsets, mask, offsetsVector);
+        numOffsets += _mm_popcnt_u32(mask);
+        offsetsVector = _mm512_add_epi32(offsetsVector, offsetsIncrement);
+    }
+
+    return numOffsets;
+}
+
+#endif
+
+/*
+Classifies left block with the widest kernel supported by host. Length of block has to be divisible by 16.
+*/
+template <order_t sortOrder>
+inline uint_t classifyLeft(data_t *keys, uint_t length, data_t pivot, uint_t *offsets)
+{
+#if DATA_TYPE_BITS == 32
+    static const bool isAvx512Supported = isHostAvx512Supported();
+    static const bool isAvx2Supported = isHostAvx2Supported();
+
+    if (isAvx512Supported)
+    {
+        return classifyLeftAvx512<sortOrder>(keys, length, pivot, offsets);
+    }
+    if (isAvx2Supported)
+    {
+        return classifyLeftAvx2<sortOrder>(keys, length, pivot, offsets);
+    }
+#endif
+
+    return classifyLeftScalar<sortOrder>(keys, length, pivot, offsets);
+}
+
+/*
+Classifies right block, which ends on "keysEnd", with the widest kernel supported by host. Length of block has to
+be divisible by 16.
+*/
+template <order_t sortOrder>
+inline uint_t classifyRight(data_t *keysEnd, uint_t length, data_t pivot, uint_t *offsets)
+{
+#if DATA_TYPE_BITS == 32
+    static const bool isAvx512Supported = isHostAvx512Supported();
+    static const bool isAvx2Supported = isHostAvx2Supported();
+
+    if (isAvx512Supported)
+    {
+        return classifyRightAvx512<sortOrder>(keysEnd, length, pivot, offsets);
+    }
+    if (isAvx2Supported)
+    {
+        return classifyRightAvx2<sortOrder>(keysEnd, length, pivot, offsets);
+    }
+#endif
+
+    return classifyRightScalar<sortOrder>(keysEnd, length, pivot, offsets);
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "math_functions.h"
 
 #include "../../Utils/data_types_common.h"
+#include "../key_transform.h"
 #include "key_value_utils.h"
 
 
@@ -16,9 +17,10 @@
 Sorts blocks in shared memory according to current radix digit. Sort is done for every separately for every
 bit of digit.
 Function template cannot be used for "elements per thread" because it has to be processed by preprocessor.
-- TODO implement for sort order DESC
+If "transformKeys" is set, keys are transformed with order-preserving key transform, when they are read from
+global memory.
 */
-template <uint_t threadsSortLocal, uint_t bitCountRadix, order_t sortOrder>
+template <uint_t threadsSortLocal, uint_t bitCountRadix, order_t sortOrder, bool transformKeys>
 __global__ void radixSortLocalKernel(data_t *keys, data_t *values, uint_t bitOffset)
 {
     extern __shared__ data_t sortLocalTile[];
@@ -33,7 +35,8 @@ __global__ void radixSortLocalKernel(data_t *keys, data_t *values, uint_t bitOff
     // Every thread reads it's corresponding elements
     for (uint_t tx = threadIdx.x; tx < elemsPerThreadBlock; tx += threadsSortLocal)
     {
-        keysTile[tx] = keys[offset + tx];
+        data_t key = keys[offset + tx];
+        keysTile[tx] = transformKeys ? transformKey<sortOrder>(key) : key;
         valuesTile[tx] = values[offset + tx];
     }
     __syncthreads();
@@ -199,8 +202,12 @@ __global__ void radixSortLocalKernel(data_t *keys, data_t *values, uint_t bitOff
 /*
 From provided offsets scatters elements to their corresponding buckets (according to radix diggit) from
 primary to buffer array.
+If "restoreKeys" is set, keys are restored to their original value, when they are written to output array.
 */
-template <uint_t threadsSortGlobal, uint_t threadsSortLocal, uint_t elemsSortLocal, uint_t radixParam>
+template <
+    uint_t threadsSortGlobal, uint_t threadsSortLocal, uint_t elemsSortLocal, uint_t radixParam, order_t sortOrder,
+    bool restoreKeys
+>
 __global__ void radixSortGlobalKernel(
     data_t *keysInput, data_t *valuesInput, data_t *keysOutput, data_t *valuesOutput, uint_t *offsetsLocal,
     uint_t *offsetsGlobal, uint_t bitOffset
@@ -245,7 +252,7 @@ __global__ void radixSortGlobalKernel(
         uint_t radix = (keysTile[tx] >> bitOffset) & (radixParam - 1);
         uint_t indexOutput = offsetsGlobalTile[radix] + tx - offsetsLocalTile[radix];
 
-        keysOutput[indexOutput] = keysTile[tx];
+        keysOutput[indexOutput] = restoreKeys ? restoreKey<sortOrder>(keysTile[tx]) : keysTile[tx];
         valuesOutput[indexOutput] = valuesTile[tx];
     }
 }
@@ -0,0 +1,378 @@
+#ifndef RADIX_SORT_HYBRID_H
+#define RADIX_SORT_HYBRID_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atomic>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "../key_transform.h"
+#include "sequential.h"
+
+
+/*
+Parent class for hybrid radix sort. Not to be used directly - it's inherited by bottom class, which performs
+partial template specialization.
+Array is first partitioned with MSD scatter on the most significant non-trivial digit into buckets. Buckets, which
+fit into L2 cache, are then sorted with LSD counting sort passes, while they are located in cache. Larger buckets
+(for example with non-uniform distributions) are partitioned again by the next digit. This way array is streamed
+through main memory only a few times instead of once per every digit.
+Buckets are sorted independently of each other, so they are distributed among host threads. Sort is stable.
+*/
+template <uint_t bitCountRadixKo, uint_t radixKo, uint_t bitCountRadixKv, uint_t radixKv>
+class RadixSortHybridParent : public RadixSortSequentialParent<bitCountRadixKo, radixKo, bitCountRadixKv, radixKv>
+{
+protected:
+    std::string _sortName = "Radix sort hybrid";
+    // Number of host threads, which sort buckets
+    uint_t _numThreads = NUM_THREADS_HYBRID > 0 ? NUM_THREADS_HYBRID : getNumHostThreads();
+    // Size of L2 cache of host in bytes
+    uint_t _cacheSizeL2 = getHostCacheSize(2) > 0 ? getHostCacheSize(2) : DEFAULT_CACHE_SIZE_L2_HYBRID;
+
+    /*
+    Returns the max number of elements in bucket, which is sorted with LSD passes. Keys, values and their buffers
+    of that bucket occupy the specified fraction of L2 cache.
+    */
+    uint_t getMaxBucketLength(bool sortingKeyOnly)
+    {
+        uint_t bytesPerElement = 2 * (sortingKeyOnly ? 1 : 2) * sizeof(data_t);
+        uint_t maxBucketLength = (uint_t)(
+            (uint64_t)_cacheSizeL2 * CACHE_PERCENT_BUCKET_HYBRID / 100 / bytesPerElement
+        );
+        return maxBucketLength > 0 ? maxBucketLength : 1;
+    }
+
+    /*
+    Counts number of element occurrences for digits from 0 to "digit" in one pass over bucket. Counters of digit
+    "d" are located in "dataCounters[d * radix]". Returns bits in which keys differ from each other.
+    */
+    template <uint_t bitCountRadix, uint_t radix>
+    data_t countBucketDigits(data_t *h_keys, uint_t *dataCounters, uint_t tableLen, int_t digit)
+    {
+        data_t keyBitsDiff = 0;
+
+        for (uint_t i = 0; i < (digit + 1) * radix; i++)
+        {
+            dataCounters[i] = 0;
+        }
+
+        for (uint_t i = 0; i < tableLen; i++)
+        {
+            data_t key = h_keys[i];
+            keyBitsDiff |= key ^ h_keys[0];
+
+            for (int_t d = 0; d <= digit; d++)
+            {
+                dataCounters[d * radix + ((key >> (d * bitCountRadix)) & (radix - 1))]++;
+            }
+        }
+
+        return keyBitsDiff;
+    }
+
+    /*
+    Restores transformed keys of sorted bucket and stores bucket to output array. If output array is the same as
+    input array, keys are only restored.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void storeBucket(
+        data_t *h_keys, data_t *h_values, data_t *h_keysOutput, data_t *h_valuesOutput, uint_t tableLen
+    )
+    {
+        if (h_keys == h_keysOutput)
+        {
+            if (isKeyTransformed<sortOrder>())
+            {
+                for (uint_t i = 0; i < tableLen; i++)
+                {
+                    h_keys[i] = restoreKey<sortOrder>(h_keys[i]);
+                }
+            }
+            return;
+        }
+
+        for (uint_t i = 0; i < tableLen; i++)
+        {
+            h_keysOutput[i] = restoreKey<sortOrder>(h_keys[i]);
+        }
+        if (!sortingKeyOnly)
+        {
+            std::copy(h_values, h_values + tableLen, h_valuesOutput);
+        }
+    }
+
+    /*
+    Sorts bucket located in "h_keys" by digits from "digit" down to 0. Buffers of the same length are used for
+    scatter. If "sortedToBuffer" is set, sorted bucket is stored to buffers, otherwise to "h_keys"/"h_values".
+    Buckets longer than "maxBucketLength" are partitioned by current digit and every partition is sorted
+    recursively. Shorter buckets are sorted with LSD counting sort passes.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t bitCountRadix, uint_t radix>
+    void sortBucket(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *dataCounters,
+        uint_t tableLen, int_t digit, uint_t maxBucketLength, bool sortedToBuffer
+    )
+    {
+        if (tableLen > maxBucketLength && digit >= 0)
+        {
+            // End index (exclusive) of every partition
+            uint_t bucketEnds[radix];
+
+            // Digits, for which all elements belong to the same partition, are skipped
+            for (; digit >= 0; digit--)
+            {
+                for (uint_t i = 0; i < radix; i++)
+                {
+                    dataCounters[i] = 0;
+                }
+                for (uint_t i = 0; i < tableLen; i++)
+                {
+                    dataCounters[(h_keys[i] >> (digit * bitCountRadix)) & (radix - 1)]++;
+                }
+
+                bool isTrivialDigit = false;
+                for (uint_t i = 0; i < radix; i++)
+                {
+                    isTrivialDigit |= dataCounters[i] == tableLen;
+                }
+
+                if (!isTrivialDigit)
+                {
+                    break;
+                }
+            }
+
+            // All keys are equal
+            if (digit < 0)
+            {
+                storeBucket<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, sortedToBuffer ? h_keysBuffer : h_keys,
+                    sortedToBuffer ? h_valuesBuffer : h_values, tableLen
+                );
+                return;
+            }
+
+            uint_t offset = 0;
+            for (uint_t i = 0; i < radix; i++)
+            {
+                offset += dataCounters[i];
+                bucketEnds[i] = offset;
+            }
+
+            this->template countingSort<sortOrder, sortingKeyOnly, radix, false>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, tableLen, digit * bitCountRadix
+            );
+
+            // Partitions are located in buffer, so roles of arrays are switched
+            uint_t bucketStart = 0;
+            for (uint_t bucket = 0; bucket < radix; bucket++)
+            {
+                sortBucket<sortOrder, sortingKeyOnly, bitCountRadix, radix>(
+                    h_keysBuffer + bucketStart, sortingKeyOnly ? NULL : h_valuesBuffer + bucketStart,
+                    h_keys + bucketStart, sortingKeyOnly ? NULL : h_values + bucketStart, dataCounters,
+                    bucketEnds[bucket] - bucketStart, digit - 1, maxBucketLength, !sortedToBuffer
+                );
+                bucketStart = bucketEnds[bucket];
+            }
+
+            return;
+        }
+
+        data_t *h_keysOutput = sortedToBuffer ? h_keysBuffer : h_keys;
+        data_t *h_valuesOutput = sortedToBuffer ? h_valuesBuffer : h_values;
+        data_t keyBitsDiff = countBucketDigits<bitCountRadix, radix>(h_keys, dataCounters, tableLen, digit);
+
+        // Executes counting sort for every non-trivial digit, while bucket is located in cache
+        for (int_t d = 0; d <= digit; d++)
+        {
+            if (((keyBitsDiff >> (d * bitCountRadix)) & (radix - 1)) == 0)
+            {
+                continue;
+            }
+
+            this->template countingSort<sortOrder, sortingKeyOnly, radix, false>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters + d * radix, tableLen,
+                d * bitCountRadix
+            );
+
+            data_t *temp = h_keys;
+            h_keys = h_keysBuffer;
+            h_keysBuffer = temp;
+
+            if (!sortingKeyOnly)
+            {
+                temp = h_values;
+                h_values = h_valuesBuffer;
+                h_valuesBuffer = temp;
+            }
+        }
+
+        storeBucket<sortOrder, sortingKeyOnly>(h_keys, h_values, h_keysOutput, h_valuesOutput, tableLen);
+    }
+
+    /*
+    Sorts data with hybrid radix sort. Sorted data is always located in primary array.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t bitCountRadix, uint_t radix>
+    void radixSortHybrid(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t numThreads,
+        uint_t maxBucketLength, uint_t arrayLength
+    )
+    {
+        if (arrayLength == 0)
+        {
+            return;
+        }
+
+        const uint_t numDigits = (DATA_TYPE_BITS - 1) / bitCountRadix + 1;
+        uint_t *threadCounters = (uint_t*)malloc(numThreads * numDigits * radix * sizeof(*threadCounters));
+        checkMallocError(threadCounters);
+
+        // Keys are transformed and counted for all digits in one pass
+        data_t keyBitsDiff = this->template countDigitOccurrences<sortOrder, bitCountRadix, radix>(
+            h_keys, threadCounters, arrayLength
+        );
+
+        // Finds the most significant digit, in which keys differ
+        int_t digit = numDigits - 1;
+        while (digit >= 0 && ((keyBitsDiff >> (digit * bitCountRadix)) & (radix - 1)) == 0)
+        {
+            digit--;
+        }
+
+        if (arrayLength <= maxBucketLength || digit < 0)
+        {
+            sortBucket<sortOrder, sortingKeyOnly, bitCountRadix, radix>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, threadCounters, arrayLength, digit,
+                maxBucketLength, false
+            );
+            free(threadCounters);
+            return;
+        }
+
+        // End index (exclusive) of every bucket
+        uint_t bucketEnds[radix];
+        uint_t *digitCounters = threadCounters + digit * radix;
+        uint_t offset = 0;
+
+        for (uint_t i = 0; i < radix; i++)
+        {
+            offset += digitCounters[i];
+            bucketEnds[i] = offset;
+        }
+
+        // MSD scatter of whole array into buckets located in buffer
+        this->template countingSortPhase<sortOrder, sortingKeyOnly, radix, false>(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, digitCounters, arrayLength, digit * bitCountRadix
+        );
+
+        // Threads take buckets one by one and store sorted buckets back to primary array
+        std::atomic<uint_t> nextBucket(0);
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            uint_t *dataCounters = threadCounters + threadIndex * numDigits * radix;
+
+            for (uint_t bucket = nextBucket++; bucket < radix; bucket = nextBucket++)
+            {
+                uint_t bucketStart = bucket > 0 ? bucketEnds[bucket - 1] : 0;
+
+                sortBucket<sortOrder, sortingKeyOnly, bitCountRadix, radix>(
+                    h_keysBuffer + bucketStart, sortingKeyOnly ? NULL : h_valuesBuffer + bucketStart,
+                    h_keys + bucketStart, sortingKeyOnly ? NULL : h_values + bucketStart, dataCounters,
+                    bucketEnds[bucket] - bucketStart, digit - 1, maxBucketLength, true
+                );
+            }
+        });
+
+        free(threadCounters);
+    }
+
+    /*
+    Wrapper for hybrid radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        uint_t maxBucketLength = getMaxBucketLength(true);
+
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            radixSortHybrid<ORDER_ASC, true, bitCountRadixKo, radixKo>(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, _numThreads, maxBucketLength, this->_arrayLength
+            );
+        }
+        else
+        {
+            radixSortHybrid<ORDER_DESC, true, bitCountRadixKo, radixKo>(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, _numThreads, maxBucketLength, this->_arrayLength
+            );
+        }
+
+        // Sorted array is always located in primary array
+        this->_numSortPhases = 0;
+    }
+
+    /*
+    Wrapper for hybrid radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        uint_t maxBucketLength = getMaxBucketLength(false);
+
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            radixSortHybrid<ORDER_ASC, false, bitCountRadixKv, radixKv>(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, _numThreads,
+                maxBucketLength, this->_arrayLength
+            );
+        }
+        else
+        {
+            radixSortHybrid<ORDER_DESC, false, bitCountRadixKv, radixKv>(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, _numThreads,
+                maxBucketLength, this->_arrayLength
+            );
+        }
+
+        // Sorted array is always located in primary array
+        this->_numSortPhases = 0;
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Sets the number of host threads, which sort buckets.
+    */
+    void setNumThreads(uint_t numThreads)
+    {
+        _numThreads = numThreads > 0 ? numThreads : 1;
+    }
+};
+
+/*
+Base class for hybrid radix sort with only one template argument for key only and key-value - number of bits in
+radix.
+*/
+template <uint_t bitCountRadixKo, uint_t bitCountRadixKv>
+class RadixSortHybridBase : public RadixSortHybridParent<
+    bitCountRadixKo, 1 << bitCountRadixKo, bitCountRadixKv, 1 << bitCountRadixKv
+>
+{};
+
+/*
+Class for hybrid radix sort.
+*/
+class RadixSortHybrid : public RadixSortHybridBase<BIT_COUNT_HYBRID_KO, BIT_COUNT_HYBRID_KV>
+{};
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef RADIX_SORT_MULTITHREADED_H
+#define RADIX_SORT_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/threads.h"
+#include "../constants.h"
+#include "../key_transform.h"
+#include "sequential.h"
+
+
+/*
+Parent class for multithreaded radix sort on host. Not to be used directly - it's inherited by bottom class, which
+performs partial template specialization.
+It is the host counterpart of parallel radix sort: every thread counts digit occurrences in its own chunk of array
+(generate buckets), global scan over all thread counters yields scatter offsets of every thread and threads than
+scatter their chunks (global radix sort). Because chunks are ordered by thread index, sort remains stable.
+*/
+template <uint_t bitCountRadixKo, uint_t radixKo, uint_t bitCountRadixKv, uint_t radixKv>
+class RadixSortMultithreadedParent : public RadixSortSequentialParent<
+    bitCountRadixKo, radixKo, bitCountRadixKv, radixKv
+>
+{
+protected:
+    std::string _sortName = "Radix sort multithreaded";
+    // Number of host threads used for sort
+    uint_t _numThreads = NUM_THREADS_MULTITHREADED > 0 ? NUM_THREADS_MULTITHREADED : getNumHostThreads();
+
+    /*
+    Returns the number of threads used for sort. Short arrays are sorted with fewer threads.
+    */
+    uint_t getNumThreadsUsed(uint_t arrayLength, uint_t minElemsPerThread)
+    {
+        uint_t numThreads = arrayLength / minElemsPerThread;
+        numThreads = numThreads < _numThreads ? numThreads : _numThreads;
+        return numThreads > 0 ? numThreads : 1;
+    }
+
+    /*
+    Performs multithreaded counting sort on provided bit offset for specified number of bits.
+    Counters of every thread are located in "threadCounters" with "radix" counters per thread.
+    If "transformKeys" is set, keys are transformed in-place with order-preserving key transform before they are
+    counted. If "restoreKeys" is set, keys are restored to their original value when scattered.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t radix>
+    void countingSortMultithreaded(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *threadCounters,
+        uint_t numThreads, uint_t tableLen, uint_t bitOffset, bool transformKeys, bool restoreKeys
+    )
+    {
+        // Every thread counts number of element occurrences in its own chunk
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            uint_t *dataCounters = threadCounters + threadIndex * radix;
+            uint_t chunkEnd = getThreadChunkEnd(threadIndex, numThreads, tableLen);
+
+            for (uint_t i = 0; i < radix; i++)
+            {
+                dataCounters[i] = 0;
+            }
+
+            for (uint_t i = getThreadChunkStart(threadIndex, numThreads, tableLen); i < chunkEnd; i++)
+            {
+                if (transformKeys)
+                {
+                    h_keys[i] = transformKey<sortOrder>(h_keys[i]);
+                }
+
+                dataCounters[(h_keys[i] >> bitOffset) & (radix - 1)]++;
+            }
+        });
+
+        // Performs EXCLUSIVE scan on counters in order (digit, thread) - yields scatter offsets of every thread
+        uint_t offset = 0;
+        for (uint_t digit = 0; digit < radix; digit++)
+        {
+            for (uint_t thread = 0; thread < numThreads; thread++)
+            {
+                uint_t *counter = &threadCounters[thread * radix + digit];
+                uint_t count = *counter;
+
+                *counter = offset;
+                offset += count;
+            }
+        }
+
+        // Every thread scatters elements of its chunk to their output position
+        runHostThreads(numThreads, [&](uint_t threadIndex)
+        {
+            uint_t *dataOffsets = threadCounters + threadIndex * radix;
+            uint_t chunkEnd = getThreadChunkEnd(threadIndex, numThreads, tableLen);
+
+            for (uint_t i = getThreadChunkStart(threadIndex, numThreads, tableLen); i < chunkEnd; i++)
+            {
+                data_t key = h_keys[i];
+                uint_t outputIndex = dataOffsets[(key >> bitOffset) & (radix - 1)]++;
+
+                h_keysBuffer[outputIndex] = restoreKeys ? restoreKey<sortOrder>(key) : key;
+                if (!sortingKeyOnly)
+                {
+                    h_valuesBuffer[outputIndex] = h_values[i];
+                }
+            }
+        });
+    }
+
+    /*
+    Sorts data with multithreaded radix sort. Returns the number of performed counting sort phases.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t bitCountRadix, uint_t radix>
+    uint_t radixSortMultithreaded(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t numThreads,
+        uint_t arrayLength
+    )
+    {
+        uint_t *threadCounters = (uint_t*)malloc(numThreads * radix * sizeof(*threadCounters));
+        checkMallocError(threadCounters);
+        uint_t numPhases = 0;
+
+        // Executes counting sort for every digit (every group of BIT_COUNT_MULTITHREADED bits)
+        for (uint_t bitOffset = 0; bitOffset < sizeof(data_t) * 8; bitOffset += bitCountRadix)
+        {
+            bool isFirstPhase = bitOffset == 0;
+            bool isLastPhase = bitOffset + bitCountRadix >= sizeof(data_t) * 8;
+
+            countingSortMultithreaded<sortOrder, sortingKeyOnly, radix>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, threadCounters, numThreads, arrayLength, bitOffset,
+                isFirstPhase && isKeyTransformed<sortOrder>(), isLastPhase && isKeyTransformed<sortOrder>()
+            );
+            numPhases++;
+
+            data_t *temp = h_keys;
+            h_keys = h_keysBuffer;
+            h_keysBuffer = temp;
+
+            if (!sortingKeyOnly)
+            {
+                temp = h_values;
+                h_values = h_valuesBuffer;
+                h_valuesBuffer = temp;
+            }
+        }
+
+        free(threadCounters);
+        return numPhases;
+    }
+
+    /*
+    Wrapper for multithreaded radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        uint_t numThreads = getNumThreadsUsed(this->_arrayLength, MIN_ELEMS_PER_THREAD_KO);
+
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            this->_numSortPhases = radixSortMultithreaded<ORDER_ASC, true, bitCountRadixKo, radixKo>(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, numThreads, this->_arrayLength
+            );
+        }
+        else
+        {
+            this->_numSortPhases = radixSortMultithreaded<ORDER_DESC, true, bitCountRadixKo, radixKo>(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, numThreads, this->_arrayLength
+            );
+        }
+    }
+
+    /*
+    Wrapper for multithreaded radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        uint_t numThreads = getNumThreadsUsed(this->_arrayLength, MIN_ELEMS_PER_THREAD_KV);
+
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            this->_numSortPhases = radixSortMultithreaded<ORDER_ASC, false, bitCountRadixKv, radixKv>(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, numThreads,
+                this->_arrayLength
+            );
+        }
+        else
+        {
+            this->_numSortPhases = radixSortMultithreaded<ORDER_DESC, false, bitCountRadixKv, radixKv>(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, numThreads,
+                this->_arrayLength
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Sets the number of host threads used for sort.
+    */
+    void setNumThreads(uint_t numThreads)
+    {
+        _numThreads = numThreads > 0 ? numThreads : 1;
+    }
+};
+
+/*
+Base class for multithreaded radix sort with only one template argument for key only and key-value - number of
+bits in radix.
+*/
+template <uint_t bitCountRadixKo, uint_t bitCountRadixKv>
+class RadixSortMultithreadedBase : public RadixSortMultithreadedParent<
+    bitCountRadixKo, 1 << bitCountRadixKo, bitCountRadixKv, 1 << bitCountRadixKv
+>
+{};
+
+/*
+Class for multithreaded radix sort.
+*/
+class RadixSortMultithreaded : public RadixSortMultithreadedBase<
+    BIT_COUNT_MULTITHREADED_KO, BIT_COUNT_MULTITHREADED_KV
+>
+{};
+
+#endif
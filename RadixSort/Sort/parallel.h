@@ -14,6 +14,7 @@
 #include "../../Utils/kernels_classes.h"
 #include "../../Utils/host.h"
 #include "../constants.h"
+#include "../key_transform.h"
 
 #define __CUDA_INTERNAL_COMPILATION__
 #include "../Kernels/common.h"
@@ -25,7 +26,8 @@
 /*
 Parent class for parallel radix sort. Not to be used directly - it's inherited by bottom class, which performs
 partial template specialization.
-TODO implement for descending order.
+Keys are transformed with order-preserving key transform (see "key_transform.h") in local sort of first phase and
+restored in global sort of last phase, which handles descending order, signed and floating-point keys.
 
 Template params:
 _Ko - Key-only
@@ -148,6 +150,7 @@ protected:
     Calls a kernel, which adds padding to array. If array length is shorter than "elemsPerThreadBlock", than
     padding is added to "elemsPerThreadBlock". I array length is greater than "elemsPerThreadBlock", then
     padding is added to the next power of 2 of array length.
+    Padding value is chosen, so that padded keys are the greatest keys after key transform.
     */
     template <order_t sortOrder, bool sortingKeyOnly>
     void addPadding(data_t *d_keys, uint_t arrayLength)
@@ -163,14 +166,23 @@ protected:
             elemsPerThreadBlock = threadsSortLocalKv * elemsSortLocalKv;
         }
 
-        runAddPaddingKernel<sortOrder>(d_keys, arrayLength, roundUp(arrayLength, elemsPerThreadBlock));
+        uint_t arrayLenRoundedUp = roundUp(arrayLength, elemsPerThreadBlock);
+
+        if (sortOrder == ORDER_ASC)
+        {
+            runAddPaddingValueKernel<PADDING_VAL_ASC_RADIX>(d_keys, arrayLength, arrayLenRoundedUp);
+        }
+        else
+        {
+            runAddPaddingValueKernel<PADDING_VAL_DESC_RADIX>(d_keys, arrayLength, arrayLenRoundedUp);
+        }
     }
 
     /*
     Runs kernel, which sorts data blocks in shared memory with radix sort according to current radix digit,
     which is specified with "bitOffset".
     */
-    template <order_t sortOrder, bool sortingKeyOnly>
+    template <order_t sortOrder, bool sortingKeyOnly, bool transformKeys>
     void runRadixSortLocalKernel(data_t *d_keys, data_t *d_values, uint_t arrayLength, uint_t bitOffset)
     {
         uint_t elemsPerThreadBlock, sharedMemSize;
@@ -192,14 +204,16 @@ protected:
         if (sortingKeyOnly)
         {
             radixSortLocalKernel
-                <threadsSortLocalKo, bitCountRadixKo, sortOrder><<<dimGrid, dimBlock, sharedMemSize>>>(
+                <threadsSortLocalKo, bitCountRadixKo, sortOrder, transformKeys>
+                <<<dimGrid, dimBlock, sharedMemSize>>>(
                 d_keys, bitOffset
             );
         }
         else
         {
             radixSortLocalKernel
-                <threadsSortLocalKv, bitCountRadixKv, sortOrder><<<dimGrid, dimBlock, sharedMemSize>>>(
+                <threadsSortLocalKv, bitCountRadixKv, sortOrder, transformKeys>
+                <<<dimGrid, dimBlock, sharedMemSize>>>(
                 d_keys, d_values, bitOffset
             );
         }
@@ -255,7 +269,7 @@ protected:
     Scatters elements to their corresponding buckets according to current radix digit, which is specified
     with "bitOffset".
     */
-    template <bool sortingKeyOnly>
+    template <order_t sortOrder, bool sortingKeyOnly, bool restoreKeys>
     void runRadixSortGlobalKernel(
         data_t *d_keys, data_t *d_values, data_t *d_keysBuffer, data_t *d_valuesBuffer, uint_t *offsetsLocal,
         uint_t *offsetsGlobal, uint_t arrayLength, uint_t bitOffset
@@ -280,7 +294,7 @@ protected:
         if (sortingKeyOnly)
         {
             radixSortGlobalKernel
-                <threadsSortGlobalKo, threadsSortLocalKo, elemsSortLocalKo, radixKo>
+                <threadsSortGlobalKo, threadsSortLocalKo, elemsSortLocalKo, radixKo, sortOrder, restoreKeys>
                 <<<dimGrid, dimBlock, sharedMemSize>>>(
                 d_keys, d_keysBuffer, offsetsLocal, offsetsGlobal, bitOffset
             );
@@ -288,7 +302,7 @@ protected:
         else
         {
             radixSortGlobalKernel
-                <threadsSortGlobalKv, threadsSortLocalKv, elemsSortLocalKv, radixKv>
+                <threadsSortGlobalKv, threadsSortLocalKv, elemsSortLocalKv, radixKv, sortOrder, restoreKeys>
                 <<<dimGrid, dimBlock, sharedMemSize>>>(
                 d_keys, d_values, d_keysBuffer, d_valuesBuffer, offsetsLocal, offsetsGlobal, bitOffset
             );
@@ -325,7 +339,16 @@ protected:
 
         for (uint_t bitOffset = 0; bitOffset < sizeof(data_t) * 8; bitOffset += bitCountRadix)
         {
-            runRadixSortLocalKernel<sortOrder, sortingKeyOnly>(d_keys, d_values, arrayLength, bitOffset);
+            // Keys are transformed in first phase and restored in last phase
+            if (bitOffset == 0 && isKeyTransformed<sortOrder>())
+            {
+                runRadixSortLocalKernel<sortOrder, sortingKeyOnly, true>(d_keys, d_values, arrayLength, bitOffset);
+            }
+            else
+            {
+                runRadixSortLocalKernel<sortOrder, sortingKeyOnly, false>(d_keys, d_values, arrayLength, bitOffset);
+            }
+
             runGenerateBucketsKernel<sortingKeyOnly>(
                 d_keys, d_bucketOffsetsLocal, d_bucketSizes, arrayLength, bitOffset
             );
@@ -339,10 +362,20 @@ protected:
                 exit(-1);
             }
 
-            runRadixSortGlobalKernel<sortingKeyOnly>(
-                d_keys, d_values, d_keysBuffer, d_valuesBuffer, d_bucketOffsetsLocal, d_bucketOffsetsGlobal,
-                arrayLength, bitOffset
-            );
+            if (bitOffset + bitCountRadix >= sizeof(data_t) * 8 && isKeyTransformed<sortOrder>())
+            {
+                runRadixSortGlobalKernel<sortOrder, sortingKeyOnly, true>(
+                    d_keys, d_values, d_keysBuffer, d_valuesBuffer, d_bucketOffsetsLocal, d_bucketOffsetsGlobal,
+                    arrayLength, bitOffset
+                );
+            }
+            else
+            {
+                runRadixSortGlobalKernel<sortOrder, sortingKeyOnly, false>(
+                    d_keys, d_values, d_keysBuffer, d_valuesBuffer, d_bucketOffsetsLocal, d_bucketOffsetsGlobal,
+                    arrayLength, bitOffset
+                );
+            }
 
             data_t *temp = d_keys;
             d_keys = d_keysBuffer;
@@ -394,7 +427,7 @@ protected:
         }
         else
         {
-            radixSortParallel<ORDER_ASC, false>(
+            radixSortParallel<ORDER_DESC, false>(
                 _d_keys, _d_values, _d_keysBuffer, _d_valuesBuffer, _d_bucketOffsetsLocal, _d_bucketOffsetsGlobal,
                 _d_bucketSizes, _arrayLength
             );
@@ -4,17 +4,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <xmmintrin.h>
+#include <emmintrin.h>
 
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
 #include "../constants.h"
+#include "../key_transform.h"
 
 
 /*
 Parent class for sequential radix sort. Not to be used directly - it's inherited by bottom class, which performs
 partial template specialization.
-TODO implement for descending order.
+Descending order, signed and floating-point keys are sorted with order-preserving key transforms (see
+"key_transform.h"), which are applied in the counting pass and restored in the last scatter pass.
 */
 template <uint_t bitCountRadixKo, uint_t radixKo, uint_t bitCountRadixKv, uint_t radixKv>
 class RadixSortSequentialParent : public SortSequential
@@ -26,8 +30,23 @@ protected:
     data_t *_h_keysBuffer = NULL;
     // Buffer for values
     data_t *_h_valuesBuffer = NULL;
-    // Counters of element occurrences - needed for sequential radix sort
+    // Counters of element occurrences for every digit - needed for sequential radix sort
     uint_t *_h_dataCounters;
+    // Per-bucket staging buffers for keys and values used by write-combining scatter
+    data_t *_h_keysStaging = NULL;
+    data_t *_h_valuesStaging = NULL;
+    // Start offsets of buckets in output array used by write-combining scatter
+    uint_t *_h_bucketStarts = NULL;
+    // Number of counting sort phases performed by last sort (phases with only one non-empty bucket are skipped)
+    uint_t _numSortPhases = 0;
+
+    /*
+    Returns the number of digits in key for provided number of bits in radix.
+    */
+    static uint_t getNumDigits(uint_t bitCountRadix)
+    {
+        return (DATA_TYPE_BITS - 1) / bitCountRadix + 1;
+    }
 
     /*
     Method for allocating memory needed both for key only and key-value sort.
@@ -36,14 +55,43 @@ protected:
     {
         SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
         uint_t maxRadix = max(radixKo, radixKv);
+        uint_t maxNumCounters = max(getNumDigits(bitCountRadixKo) * radixKo, getNumDigits(bitCountRadixKv) * radixKv);
 
         // Allocates keys and values
         _h_keysBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_keysBuffer));
         checkMallocError(_h_keysBuffer);
         _h_valuesBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_valuesBuffer));
         checkMallocError(_h_valuesBuffer);
-        _h_dataCounters = (uint_t*)malloc(maxRadix * sizeof(*_h_dataCounters));
+
+        memoryAllocateBuckets(maxRadix, maxNumCounters);
+    }
+
+    /*
+    Allocates memory, which depends on the number of buckets - digit counters and staging buffers.
+    */
+    void memoryAllocateBuckets(uint_t maxRadix, uint_t maxNumCounters)
+    {
+        _h_dataCounters = (uint_t*)malloc(maxNumCounters * sizeof(*_h_dataCounters));
         checkMallocError(_h_dataCounters);
+
+        // Staging buffers are aligned to cache line
+        _h_keysStaging = (data_t*)_mm_malloc(maxRadix * ELEMS_STAGING_BUFFER * sizeof(*_h_keysStaging), 64);
+        checkMallocError(_h_keysStaging);
+        _h_valuesStaging = (data_t*)_mm_malloc(maxRadix * ELEMS_STAGING_BUFFER * sizeof(*_h_valuesStaging), 64);
+        checkMallocError(_h_valuesStaging);
+        _h_bucketStarts = (uint_t*)malloc(maxRadix * sizeof(*_h_bucketStarts));
+        checkMallocError(_h_bucketStarts);
+    }
+
+    /*
+    Frees memory, which depends on the number of buckets.
+    */
+    void memoryDestroyBuckets()
+    {
+        free(_h_dataCounters);
+        _mm_free(_h_keysStaging);
+        _mm_free(_h_valuesStaging);
+        free(_h_bucketStarts);
     }
 
     /*
@@ -53,10 +101,8 @@ protected:
     virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
     {
         bool sortingKeyOnly = h_values == NULL;
-        uint_t bitCountRadix = sortingKeyOnly ? bitCountRadixKo : bitCountRadixKv;
-        uint_t numPhases = DATA_TYPE_BITS / bitCountRadix;
 
-        if (numPhases % 2 == 0)
+        if (_numSortPhases % 2 == 0)
         {
             SortSequential::memoryCopyAfterSort(h_keys, h_values, arrayLength);
         }
@@ -72,26 +118,218 @@ protected:
     }
 
     /*
-    Performs sequential counting sort on provided bit offset for specified number of bits.
+    Counts number of element occurrences for all digits in one pass over keys. Counters of digit "d" are located
+    in "dataCounters[d * radix]". Returns bits in which keys differ from each other (subset of bits of
+    "min XOR max").
+    Keys are transformed in-place with order-preserving key transform.
     */
-    template <order_t sortOrder, bool sortingKeyOnly, uint_t radix>
-    void countingSort(
+    template <order_t sortOrder, uint_t bitCountRadix, uint_t radix>
+    data_t countDigitOccurrences(data_t *h_keys, uint_t *dataCounters, uint_t tableLen)
+    {
+        const uint_t numDigits = (DATA_TYPE_BITS - 1) / bitCountRadix + 1;
+        data_t firstKey = transformKey<sortOrder>(h_keys[0]);
+        data_t keyBitsDiff = 0;
+
+        // Resets counters
+        for (uint_t i = 0; i < numDigits * radix; i++)
+        {
+            dataCounters[i] = 0;
+        }
+
+        for (uint_t i = 0; i < tableLen; i++)
+        {
+            data_t key = transformKey<sortOrder>(h_keys[i]);
+            keyBitsDiff |= key ^ firstKey;
+
+            if (isKeyTransformed<sortOrder>())
+            {
+                h_keys[i] = key;
+            }
+
+            for (uint_t digit = 0; digit < numDigits; digit++)
+            {
+                dataCounters[digit * radix + ((key >> (digit * bitCountRadix)) & (radix - 1))]++;
+            }
+        }
+
+        return keyBitsDiff;
+    }
+
+    /*
+    Returns the position (in elements) of the first element of array inside its cache line. Staging buffers are
+    filled at the same positions as elements have in their output cache line, so every full staging buffer can be
+    flushed to one aligned cache line.
+    */
+    uint_t getCacheLineOffset(data_t *h_array)
+    {
+        return (uint_t)((uintptr_t)h_array / sizeof(*h_array)) & (ELEMS_STAGING_BUFFER - 1);
+    }
+
+    /*
+    Stores one cache line from staging buffer to output with non-temporal (streaming) stores, which bypass cache.
+    Both staging buffer and output have to be aligned to cache line.
+    */
+    void streamCacheLine(data_t *staging, data_t *output)
+    {
+        for (uint_t i = 0; i < ELEMS_STAGING_BUFFER * sizeof(data_t) / sizeof(__m128i); i++)
+        {
+            _mm_stream_si128((__m128i*)output + i, _mm_load_si128((__m128i*)staging + i));
+        }
+    }
+
+    /*
+    Copies elements from staging buffer to their output position. Only full cache lines are flushed with
+    streaming stores, partial lines (at start and end of bucket) are written with regular stores.
+    */
+    template <bool useStreamingStores>
+    void flushStagingBuffer(data_t *staging, data_t *output, uint_t numElements)
+    {
+        if (useStreamingStores && numElements == ELEMS_STAGING_BUFFER)
+        {
+            streamCacheLine(staging, output);
+            return;
+        }
+
+        for (uint_t i = 0; i < numElements; i++)
+        {
+            output[i] = staging[i];
+        }
+    }
+
+    /*
+    Stores element to staging buffer of its bucket. If element completes its output cache line, staged elements of
+    that line are flushed. The first line of bucket usually starts before bucket, so it is only partially filled.
+    */
+    template <bool useStreamingStores>
+    void stageElement(
+        data_t element, data_t *staging, data_t *output, uint_t outputIndex, uint_t bucketStart, uint_t lineOffset
+    )
+    {
+        uint_t stagingIndex = (outputIndex + lineOffset) & (ELEMS_STAGING_BUFFER - 1);
+        staging[stagingIndex] = element;
+
+        if (stagingIndex < ELEMS_STAGING_BUFFER - 1)
+        {
+            return;
+        }
+
+        uint_t numElements = min((uint_t)ELEMS_STAGING_BUFFER, outputIndex - bucketStart + 1);
+        flushStagingBuffer<useStreamingStores>(
+            staging + ELEMS_STAGING_BUFFER - numElements, output + outputIndex + 1 - numElements, numElements
+        );
+
+        // With regular stores the destination of next flush of this bucket is prefetched
+        if (!useStreamingStores)
+        {
+            _mm_prefetch((char*)(output + outputIndex + 1), _MM_HINT_T0);
+        }
+    }
+
+    /*
+    Flushes elements of the last (partially filled) cache line of bucket with regular stores.
+    */
+    void flushStagedTail(data_t *staging, data_t *output, uint_t bucketEnd, uint_t bucketStart, uint_t lineOffset)
+    {
+        uint_t stagingIndex = (bucketEnd + lineOffset) & (ELEMS_STAGING_BUFFER - 1);
+        uint_t numElements = min(stagingIndex, bucketEnd - bucketStart);
+
+        flushStagingBuffer<false>(
+            staging + stagingIndex - numElements, output + bucketEnd - numElements, numElements
+        );
+    }
+
+    /*
+    Performs sequential counting sort with write-combining scatter. Elements are first staged in cache line sized
+    buffer of their bucket at the same position, as they will have in their output cache line. When output cache
+    line is complete, staging buffer is flushed with one burst of (streaming) stores. This way only one cache line
+    per bucket is written at a time instead of "radix" random locations, and streaming stores always write whole
+    aligned cache lines.
+    Counters have to already contain number of occurrences of every digit (see "countDigitOccurrences").
+    If "restoreKeys" is set, transformed keys are restored to their original value when scattered.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t radix, bool restoreKeys>
+    void countingSortWriteCombining(
         data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *dataCounters,
-        uint_t tableLen, uint_t bitOffset
+        data_t *h_keysStaging, data_t *h_valuesStaging, uint_t *bucketStarts, uint_t tableLen, uint_t bitOffset
     )
     {
-        // Resets counters
+        // Keys and values can be differently aligned, so their staging positions are calculated separately
+        uint_t keysLineOffset = getCacheLineOffset(h_keysBuffer);
+        uint_t valuesLineOffset = sortingKeyOnly ? 0 : getCacheLineOffset(h_valuesBuffer);
+
+        // Performs EXCLUSIVE scan on counters
+        uint_t offset = 0;
         for (uint_t i = 0; i < radix; i++)
         {
-            dataCounters[i] = 0;
+            uint_t count = dataCounters[i];
+            dataCounters[i] = offset;
+            bucketStarts[i] = offset;
+            offset += count;
         }
 
-        // Counts number of element occurrences
+        // Stages elements in buffers of their buckets in the same order as they are located in input array
         for (uint_t i = 0; i < tableLen; i++)
         {
-            dataCounters[(h_keys[i] >> bitOffset) & (radix - 1)]++;
+            _mm_prefetch((char*)(h_keys + i + PREFETCH_DISTANCE_SCATTER), _MM_HINT_NTA);
+            if (!sortingKeyOnly)
+            {
+                _mm_prefetch((char*)(h_values + i + PREFETCH_DISTANCE_SCATTER), _MM_HINT_NTA);
+            }
+
+            data_t key = h_keys[i];
+            uint_t bucket = (key >> bitOffset) & (radix - 1);
+            uint_t stagingOffset = bucket * ELEMS_STAGING_BUFFER;
+            uint_t outputIndex = dataCounters[bucket]++;
+
+            stageElement<USE_STREAMING_STORES_SCATTER>(
+                restoreKeys ? restoreKey<sortOrder>(key) : key, h_keysStaging + stagingOffset, h_keysBuffer,
+                outputIndex, bucketStarts[bucket], keysLineOffset
+            );
+            if (!sortingKeyOnly)
+            {
+                stageElement<USE_STREAMING_STORES_SCATTER>(
+                    h_values[i], h_valuesStaging + stagingOffset, h_valuesBuffer, outputIndex, bucketStarts[bucket],
+                    valuesLineOffset
+                );
+            }
         }
 
+        // Flushes partially filled staging buffers
+        for (uint_t bucket = 0; bucket < radix; bucket++)
+        {
+            uint_t stagingOffset = bucket * ELEMS_STAGING_BUFFER;
+
+            flushStagedTail(
+                h_keysStaging + stagingOffset, h_keysBuffer, dataCounters[bucket], bucketStarts[bucket],
+                keysLineOffset
+            );
+            if (!sortingKeyOnly)
+            {
+                flushStagedTail(
+                    h_valuesStaging + stagingOffset, h_valuesBuffer, dataCounters[bucket], bucketStarts[bucket],
+                    valuesLineOffset
+                );
+            }
+        }
+
+        // Streaming stores are weakly ordered
+        if (USE_STREAMING_STORES_SCATTER)
+        {
+            _mm_sfence();
+        }
+    }
+
+    /*
+    Performs sequential counting sort on provided bit offset for specified number of bits. Counters have to
+    already contain number of occurrences of every digit (see "countDigitOccurrences").
+    If "restoreKeys" is set, transformed keys are restored to their original value when scattered.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t radix, bool restoreKeys>
+    void countingSort(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *dataCounters,
+        uint_t tableLen, uint_t bitOffset
+    )
+    {
         // Performs scan on counters
         for (uint_t i = 1; i < radix; i++)
         {
@@ -101,9 +339,10 @@ protected:
         // Scatters elements to their output position
         for (int_t i = tableLen - 1; i >= 0; i--)
         {
-            uint_t outputIndex = --dataCounters[(h_keys[i] >> bitOffset) & (radix - 1)];
+            data_t key = h_keys[i];
+            uint_t outputIndex = --dataCounters[(key >> bitOffset) & (radix - 1)];
 
-            h_keysBuffer[outputIndex] = h_keys[i];
+            h_keysBuffer[outputIndex] = restoreKeys ? restoreKey<sortOrder>(key) : key;
             if (!sortingKeyOnly)
             {
                 h_valuesBuffer[outputIndex] = h_values[i];
@@ -112,20 +351,96 @@ protected:
     }
 
     /*
-    Sorts data sequentially with radix sort.
+    Performs counting sort phase with scatter, which is suitable for provided array length.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t radix, bool restoreKeys>
+    void countingSortPhase(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *dataCounters,
+        uint_t tableLen, uint_t bitOffset
+    )
+    {
+        if (tableLen >= THRESHOLD_WRITE_COMBINING_SCATTER)
+        {
+            countingSortWriteCombining<sortOrder, sortingKeyOnly, radix, restoreKeys>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, _h_keysStaging, _h_valuesStaging,
+                _h_bucketStarts, tableLen, bitOffset
+            );
+        }
+        else
+        {
+            countingSort<sortOrder, sortingKeyOnly, radix, restoreKeys>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, tableLen, bitOffset
+            );
+        }
+    }
+
+    /*
+    Sorts data sequentially with radix sort. Returns the number of performed counting sort phases (needed to
+    determine, if sorted array is located in primary or buffer array).
     */
     template <order_t sortOrder, bool sortingKeyOnly, uint_t bitCountRadix, uint_t radix>
-    void radixSortSequential(
+    uint_t radixSortSequential(
         data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *dataCounters,
         uint_t arrayLength
     )
     {
+        uint_t numPhases = 0;
+        if (arrayLength == 0)
+        {
+            return numPhases;
+        }
+
+        data_t keyBitsDiff = countDigitOccurrences<sortOrder, bitCountRadix, radix>(
+            h_keys, dataCounters, arrayLength
+        );
+
+        // Bit offset of the last digit, for which keys are scattered - in that phase keys are restored
+        int_t lastBitOffset = -1;
+        for (uint_t bitOffset = 0; bitOffset < sizeof(data_t)* 8; bitOffset += bitCountRadix)
+        {
+            if (((keyBitsDiff >> bitOffset) & (radix - 1)) != 0)
+            {
+                lastBitOffset = bitOffset;
+            }
+        }
+
+        // All keys are equal - only key transform has to be reverted
+        if (lastBitOffset == -1)
+        {
+            if (isKeyTransformed<sortOrder>())
+            {
+                for (uint_t i = 0; i < arrayLength; i++)
+                {
+                    h_keys[i] = restoreKey<sortOrder>(h_keys[i]);
+                }
+            }
+            return numPhases;
+        }
+
         // Executes counting sort for every digit (every group of BIT_COUNT_SEQUENTIAL bits)
         for (uint_t bitOffset = 0; bitOffset < sizeof(data_t)* 8; bitOffset += bitCountRadix)
         {
-            countingSort<sortOrder, sortingKeyOnly, radix>(
-                h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, arrayLength, bitOffset
-            );
+            uint_t *digitCounters = dataCounters + (bitOffset / bitCountRadix) * radix;
+
+            // If all keys have the same digit, all elements would end up in the same bucket
+            if (((keyBitsDiff >> bitOffset) & (radix - 1)) == 0)
+            {
+                continue;
+            }
+
+            if ((int_t)bitOffset == lastBitOffset)
+            {
+                countingSortPhase<sortOrder, sortingKeyOnly, radix, true>(
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, digitCounters, arrayLength, bitOffset
+                );
+            }
+            else
+            {
+                countingSortPhase<sortOrder, sortingKeyOnly, radix, false>(
+                    h_keys, h_values, h_keysBuffer, h_valuesBuffer, digitCounters, arrayLength, bitOffset
+                );
+            }
+            numPhases++;
 
             data_t *temp = h_keys;
             h_keys = h_keysBuffer;
@@ -138,6 +453,8 @@ protected:
                 h_valuesBuffer = temp;
             }
         }
+
+        return numPhases;
     }
 
     /*
@@ -148,13 +465,13 @@ protected:
     {
         if (_sortOrder == ORDER_ASC)
         {
-            radixSortSequential<ORDER_ASC, true, bitCountRadixKo, radixKo>(
+            _numSortPhases = radixSortSequential<ORDER_ASC, true, bitCountRadixKo, radixKo>(
                 _h_keys, NULL, _h_keysBuffer, NULL, _h_dataCounters, _arrayLength
             );
         }
         else
         {
-            radixSortSequential<ORDER_DESC, true, bitCountRadixKo, radixKo>(
+            _numSortPhases = radixSortSequential<ORDER_DESC, true, bitCountRadixKo, radixKo>(
                 _h_keys, NULL, _h_keysBuffer, NULL, _h_dataCounters, _arrayLength
             );
         }
@@ -168,13 +485,13 @@ protected:
     {
         if (_sortOrder == ORDER_ASC)
         {
-            radixSortSequential<ORDER_ASC, false, bitCountRadixKv, radixKv>(
+            _numSortPhases = radixSortSequential<ORDER_ASC, false, bitCountRadixKv, radixKv>(
                 _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_dataCounters, _arrayLength
             );
         }
         else
         {
-            radixSortSequential<ORDER_DESC, false, bitCountRadixKv, radixKv>(
+            _numSortPhases = radixSortSequential<ORDER_DESC, false, bitCountRadixKv, radixKv>(
                 _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_dataCounters, _arrayLength
             );
         }
@@ -200,7 +517,7 @@ public:
 
         free(_h_keysBuffer);
         free(_h_valuesBuffer);
-        free(_h_dataCounters);
+        memoryDestroyBuckets();
     }
 };
 
@@ -0,0 +1,231 @@
+#ifndef RADIX_SORT_SEQUENTIAL_ADAPTIVE_H
+#define RADIX_SORT_SEQUENTIAL_ADAPTIVE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../constants.h"
+#include "sequential.h"
+
+
+/*
+Class for sequential radix sort, which selects the number of bits in radix digit at runtime. Sort is compiled for
+every digit width between BIT_COUNT_ADAPTIVE_MIN and BIT_COUNT_ADAPTIVE_MAX. Width is selected according to array
+length, range of keys and cache sizes of host, which are detected when sort is created.
+Counters and staging buffers are allocated for the narrowest digit and are reallocated only when wider digit is
+selected, so short arrays don't allocate buckets for the widest digit.
+*/
+class RadixSortSequentialAdaptive : public RadixSortSequentialBase<BIT_COUNT_ADAPTIVE_MIN, BIT_COUNT_ADAPTIVE_MIN>
+{
+protected:
+    std::string _sortName = "Radix sort sequential adaptive";
+
+    // Cache sizes of host in bytes
+    uint_t _cacheSizeL1 = getCacheSize(1, DEFAULT_CACHE_SIZE_L1_ADAPTIVE);
+    uint_t _cacheSizeL2 = getCacheSize(2, DEFAULT_CACHE_SIZE_L2_ADAPTIVE);
+    // Number of bits in radix digit used by last sort
+    uint_t _bitCountRadix = BIT_COUNT_ADAPTIVE_MIN;
+    // Number of bits in radix digit, for which counters and staging buffers are currently allocated
+    uint_t _bitCountRadixAllocated = BIT_COUNT_ADAPTIVE_MIN;
+
+    /*
+    Returns the size of cache on provided level. If it can't be detected, default size is returned.
+    */
+    static uint_t getCacheSize(uint_t level, uint_t defaultSize)
+    {
+        uint_t cacheSize = getHostCacheSize(level);
+        return cacheSize > 0 ? cacheSize : defaultSize;
+    }
+
+    void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        RadixSortSequentialBase<BIT_COUNT_ADAPTIVE_MIN, BIT_COUNT_ADAPTIVE_MIN>::memoryAllocate(
+            h_keys, h_values, arrayLength
+        );
+        _bitCountRadixAllocated = BIT_COUNT_ADAPTIVE_MIN;
+    }
+
+    /*
+    Reallocates counters and staging buffers, if they are too small for provided number of bits in radix digit.
+    */
+    void memoryAllocateRadix(uint_t bitCountRadix)
+    {
+        if (bitCountRadix <= _bitCountRadixAllocated)
+        {
+            return;
+        }
+
+        memoryDestroyBuckets();
+        memoryAllocateBuckets(1 << bitCountRadix, getNumDigits(bitCountRadix) * (1 << bitCountRadix));
+        _bitCountRadixAllocated = bitCountRadix;
+    }
+
+    /*
+    Returns bits in which (transformed) keys differ from each other. Digits without any of these bits are the same
+    for all keys, so their counting sort phases are skipped (see "radixSortSequential").
+    */
+    template <order_t sortOrder>
+    data_t getKeyBitsDiff(data_t *h_keys, uint_t arrayLength)
+    {
+        if (arrayLength == 0)
+        {
+            return 0;
+        }
+
+        data_t firstKey = transformKey<sortOrder>(h_keys[0]);
+        data_t keyBitsDiff = 0;
+
+        for (uint_t i = 1; i < arrayLength; i++)
+        {
+            keyBitsDiff |= transformKey<sortOrder>(h_keys[i]) ^ firstKey;
+        }
+
+        return keyBitsDiff;
+    }
+
+    /*
+    Selects the number of bits in radix digit with the lowest estimated cost. Cost of one counting sort phase is
+    proportional to array length and number of buckets. Scatter gets slower, when buckets (one cache line per
+    bucket for keys and values) and digit counters don't fit into L1 or L2 cache. This way short arrays are
+    sorted with fewer buckets and long arrays with fewer phases.
+    Only phases of digits, in which keys differ ("keyBitsDiff"), are counted, because other phases are skipped.
+    */
+    uint_t selectBitCountRadix(uint_t arrayLength, data_t keyBitsDiff, bool sortingKeyOnly)
+    {
+        uint_t bytesPerBucket = (sortingKeyOnly ? 1 : 2) * ELEMS_STAGING_BUFFER * sizeof(data_t);
+        uint_t bitCountRadixMin = BIT_COUNT_ADAPTIVE_MIN;
+        uint64_t costMin = 0;
+
+        for (uint_t bitCountRadix = BIT_COUNT_ADAPTIVE_MIN; bitCountRadix <= BIT_COUNT_ADAPTIVE_MAX; bitCountRadix++)
+        {
+            uint_t radix = 1 << bitCountRadix;
+            uint_t numDigits = getNumDigits(bitCountRadix);
+            uint_t numPhases = 0;
+
+            for (uint_t digit = 0; digit < numDigits; digit++)
+            {
+                if (((keyBitsDiff >> (digit * bitCountRadix)) & (radix - 1)) != 0)
+                {
+                    numPhases++;
+                }
+            }
+
+            uint64_t workingSet = (uint64_t)radix * bytesPerBucket + (uint64_t)numDigits * radix * sizeof(uint_t);
+            uint64_t scatterCost = 100;
+
+            if (workingSet > _cacheSizeL2)
+            {
+                scatterCost = SCATTER_COST_MEMORY_ADAPTIVE;
+            }
+            else if (workingSet > _cacheSizeL1)
+            {
+                scatterCost = SCATTER_COST_L2_ADAPTIVE;
+            }
+
+            uint64_t cost = numPhases * (arrayLength * scatterCost + radix * 100);
+            if (bitCountRadix == BIT_COUNT_ADAPTIVE_MIN || cost < costMin)
+            {
+                bitCountRadixMin = bitCountRadix;
+                costMin = cost;
+            }
+        }
+
+        return bitCountRadixMin;
+    }
+
+    /*
+    Sorts data with radix sort compiled for digit width "bitCountRadix". If it differs from provided digit width,
+    sort compiled for the next digit width is called. Returns the number of performed counting sort phases.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t bitCountRadix>
+    uint_t radixSortAdaptive(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, uint_t *dataCounters,
+        uint_t arrayLength, uint_t bitCountRadixSelected
+    )
+    {
+        if (bitCountRadix >= bitCountRadixSelected || bitCountRadix >= BIT_COUNT_ADAPTIVE_MAX)
+        {
+            return radixSortSequential<sortOrder, sortingKeyOnly, bitCountRadix, 1 << bitCountRadix>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, arrayLength
+            );
+        }
+
+        return radixSortAdaptive<
+            sortOrder, sortingKeyOnly, (bitCountRadix < BIT_COUNT_ADAPTIVE_MAX ? bitCountRadix + 1 : bitCountRadix)
+        >(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, arrayLength, bitCountRadixSelected
+        );
+    }
+
+    /*
+    Wrapper for adaptive radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        data_t keyBitsDiff = _sortOrder == ORDER_ASC
+            ? getKeyBitsDiff<ORDER_ASC>(_h_keys, _arrayLength)
+            : getKeyBitsDiff<ORDER_DESC>(_h_keys, _arrayLength);
+        _bitCountRadix = selectBitCountRadix(_arrayLength, keyBitsDiff, true);
+        memoryAllocateRadix(_bitCountRadix);
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            _numSortPhases = radixSortAdaptive<ORDER_ASC, true, BIT_COUNT_ADAPTIVE_MIN>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_dataCounters, _arrayLength, _bitCountRadix
+            );
+        }
+        else
+        {
+            _numSortPhases = radixSortAdaptive<ORDER_DESC, true, BIT_COUNT_ADAPTIVE_MIN>(
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_dataCounters, _arrayLength, _bitCountRadix
+            );
+        }
+    }
+
+    /*
+    Wrapper for adaptive radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        data_t keyBitsDiff = _sortOrder == ORDER_ASC
+            ? getKeyBitsDiff<ORDER_ASC>(_h_keys, _arrayLength)
+            : getKeyBitsDiff<ORDER_DESC>(_h_keys, _arrayLength);
+        _bitCountRadix = selectBitCountRadix(_arrayLength, keyBitsDiff, false);
+        memoryAllocateRadix(_bitCountRadix);
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            _numSortPhases = radixSortAdaptive<ORDER_ASC, false, BIT_COUNT_ADAPTIVE_MIN>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_dataCounters, _arrayLength, _bitCountRadix
+            );
+        }
+        else
+        {
+            _numSortPhases = radixSortAdaptive<ORDER_DESC, false, BIT_COUNT_ADAPTIVE_MIN>(
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_dataCounters, _arrayLength, _bitCountRadix
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Returns the number of bits in radix digit, which was used by last sort.
+    */
+    uint_t getBitCountRadix()
+    {
+        return _bitCountRadix;
+    }
+};
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef RADIX_SORT_SEQUENTIAL_IN_PLACE_H
+#define RADIX_SORT_SEQUENTIAL_IN_PLACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../constants.h"
+#include "../key_transform.h"
+
+
+/*
+Parent class for sequential in-place MSD radix sort (American flag sort). Not to be used directly - it's inherited
+by bottom class, which performs partial template specialization.
+Elements are permuted into buckets of most significant digit with cycle-leader permutation, after which every
+bucket is recursively sorted by next digit. No buffers of array length are needed. Sort is NOT stable.
+Digits and comparisons are computed from transformed keys (see "key_transform.h"), which handles descending
+order, signed and floating-point keys.
+*/
+template <
+    uint_t bitCountRadixKo, uint_t radixKo, uint_t bitCountRadixKv, uint_t radixKv,
+    uint_t smallSortThresholdKo, uint_t smallSortThresholdKv
+>
+class RadixSortSequentialInPlaceParent : public SortSequential
+{
+protected:
+    std::string _sortName = "Radix sort in-place sequential";
+
+    /*
+    Sorts short arrays with insertion sort.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void insertionSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        for (uint_t i = 1; i < arrayLength; i++)
+        {
+            data_t key = h_keys[i];
+            data_t value = sortingKeyOnly ? 0 : h_values[i];
+            int_t j = i - 1;
+
+            while (j >= 0 && transformKey<sortOrder>(h_keys[j]) > transformKey<sortOrder>(key))
+            {
+                h_keys[j + 1] = h_keys[j];
+                if (!sortingKeyOnly)
+                {
+                    h_values[j + 1] = h_values[j];
+                }
+                j--;
+            }
+
+            h_keys[j + 1] = key;
+            if (!sortingKeyOnly)
+            {
+                h_values[j + 1] = value;
+            }
+        }
+    }
+
+    /*
+    Returns the bucket of element for provided bit offset.
+    */
+    template <order_t sortOrder, uint_t radix>
+    uint_t getBucket(data_t key, uint_t bitOffset)
+    {
+        return (transformKey<sortOrder>(key) >> bitOffset) & (radix - 1);
+    }
+
+    /*
+    Sorts data in-place with MSD radix sort, starting with digit on provided bit offset.
+    */
+    template <
+        order_t sortOrder, bool sortingKeyOnly, uint_t bitCountRadix, uint_t radix, uint_t smallSortThreshold
+    >
+    void radixSortSequentialInPlace(data_t *h_keys, data_t *h_values, uint_t arrayLength, int_t bitOffset)
+    {
+        if (arrayLength <= smallSortThreshold)
+        {
+            insertionSort<sortOrder, sortingKeyOnly>(h_keys, h_values, arrayLength);
+            return;
+        }
+
+        // Holds bucket sizes and after scan the next free position (head) of every bucket
+        uint_t bucketHeads[radix];
+        // End index (exclusive) of every bucket
+        uint_t bucketEnds[radix];
+
+        // Digits, for which all elements belong to the same bucket, are skipped
+        for (; bitOffset >= 0; bitOffset -= bitCountRadix)
+        {
+            bool isTrivialDigit = false;
+
+            for (uint_t i = 0; i < radix; i++)
+            {
+                bucketHeads[i] = 0;
+            }
+            for (uint_t i = 0; i < arrayLength; i++)
+            {
+                bucketHeads[getBucket<sortOrder, radix>(h_keys[i], bitOffset)]++;
+            }
+            for (uint_t i = 0; i < radix; i++)
+            {
+                isTrivialDigit |= bucketHeads[i] == arrayLength;
+            }
+
+            if (!isTrivialDigit)
+            {
+                break;
+            }
+        }
+
+        // All keys are equal
+        if (bitOffset < 0)
+        {
+            return;
+        }
+
+        // Performs EXCLUSIVE scan on bucket sizes
+        uint_t offset = 0;
+        for (uint_t i = 0; i < radix; i++)
+        {
+            uint_t bucketSize = bucketHeads[i];
+            bucketHeads[i] = offset;
+            offset += bucketSize;
+            bucketEnds[i] = offset;
+        }
+
+        // Cycle-leader permutation - every element is moved directly to the head of its bucket and the element
+        // found there is carried on until an element belonging to current bucket is found.
+        for (uint_t bucket = 0; bucket < radix; bucket++)
+        {
+            while (bucketHeads[bucket] < bucketEnds[bucket])
+            {
+                data_t key = h_keys[bucketHeads[bucket]];
+                data_t value = sortingKeyOnly ? 0 : h_values[bucketHeads[bucket]];
+                uint_t keyBucket = getBucket<sortOrder, radix>(key, bitOffset);
+
+                while (keyBucket != bucket)
+                {
+                    uint_t index = bucketHeads[keyBucket]++;
+
+                    data_t temp = h_keys[index];
+                    h_keys[index] = key;
+                    key = temp;
+
+                    if (!sortingKeyOnly)
+                    {
+                        temp = h_values[index];
+                        h_values[index] = value;
+                        value = temp;
+                    }
+
+                    keyBucket = getBucket<sortOrder, radix>(key, bitOffset);
+                }
+
+                h_keys[bucketHeads[bucket]] = key;
+                if (!sortingKeyOnly)
+                {
+                    h_values[bucketHeads[bucket]] = value;
+                }
+                bucketHeads[bucket]++;
+            }
+        }
+
+        // Elements in buckets of last digit are equal
+        if (bitOffset == 0)
+        {
+            return;
+        }
+
+        // Recursively sorts buckets by next digit
+        uint_t bucketStart = 0;
+        for (uint_t bucket = 0; bucket < radix; bucket++)
+        {
+            uint_t bucketSize = bucketEnds[bucket] - bucketStart;
+
+            if (bucketSize > 1)
+            {
+                radixSortSequentialInPlace<
+                    sortOrder, sortingKeyOnly, bitCountRadix, radix, smallSortThreshold
+                >(
+                    h_keys + bucketStart, sortingKeyOnly ? NULL : h_values + bucketStart, bucketSize,
+                    bitOffset - bitCountRadix
+                );
+            }
+
+            bucketStart = bucketEnds[bucket];
+        }
+    }
+
+    /*
+    Returns the bit offset of most significant digit.
+    */
+    int_t getMostSignificantDigitOffset(uint_t bitCountRadix)
+    {
+        return ((DATA_TYPE_BITS - 1) / bitCountRadix) * bitCountRadix;
+    }
+
+    /*
+    Wrapper for in-place radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        int_t bitOffset = getMostSignificantDigitOffset(bitCountRadixKo);
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            radixSortSequentialInPlace<ORDER_ASC, true, bitCountRadixKo, radixKo, smallSortThresholdKo>(
+                _h_keys, NULL, _arrayLength, bitOffset
+            );
+        }
+        else
+        {
+            radixSortSequentialInPlace<ORDER_DESC, true, bitCountRadixKo, radixKo, smallSortThresholdKo>(
+                _h_keys, NULL, _arrayLength, bitOffset
+            );
+        }
+    }
+
+    /*
+    Wrapper for in-place radix sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        int_t bitOffset = getMostSignificantDigitOffset(bitCountRadixKv);
+
+        if (_sortOrder == ORDER_ASC)
+        {
+            radixSortSequentialInPlace<ORDER_ASC, false, bitCountRadixKv, radixKv, smallSortThresholdKv>(
+                _h_keys, _h_values, _arrayLength, bitOffset
+            );
+        }
+        else
+        {
+            radixSortSequentialInPlace<ORDER_DESC, false, bitCountRadixKv, radixKv, smallSortThresholdKv>(
+                _h_keys, _h_values, _arrayLength, bitOffset
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+};
+
+/*
+Base class for sequential in-place radix sort with only one template argument for key only and key-value -
+number of bits in radix.
+*/
+template <
+    uint_t bitCountRadixKo, uint_t bitCountRadixKv, uint_t smallSortThresholdKo, uint_t smallSortThresholdKv
+>
+class RadixSortSequentialInPlaceBase : public RadixSortSequentialInPlaceParent<
+    bitCountRadixKo, 1 << bitCountRadixKo, bitCountRadixKv, 1 << bitCountRadixKv,
+    smallSortThresholdKo, smallSortThresholdKv
+>
+{};
+
+/*
+Class for sequential in-place radix sort.
+*/
+class RadixSortSequentialInPlace : public RadixSortSequentialInPlaceBase<
+    BIT_COUNT_IN_PLACE_KO, BIT_COUNT_IN_PLACE_KV, SMALL_SORT_THRESHOLD_IN_PLACE_KO, SMALL_SORT_THRESHOLD_IN_PLACE_KV
+>
+{};
+
+#endif
@@ -9,6 +9,17 @@ _KO: Key-only
 _KV: Key-value
 */
 
+/* --------------------- KEY TYPE -------------------- */
+
+// Keys are stored in "data_t". Radix sort can interpret their bits as unsigned integers, signed integers (two's
+// complement) or floating-point numbers (float for 32-bit and double for 64-bit "data_t").
+#define KEY_TYPE_UNSIGNED 0
+#define KEY_TYPE_SIGNED 1
+#define KEY_TYPE_FLOAT 2
+// How keys are interpreted by sequential, multithreaded and parallel radix sort.
+#define RADIX_KEY_TYPE KEY_TYPE_UNSIGNED
+
+
 /* ------------------ PADDING KERNEL ----------------- */
 
 // How many threads are used per on thread block for padding. Has to be power of 2.
@@ -89,4 +100,92 @@ _KV: Key-value
 #define BIT_COUNT_SEQUENTIAL_KV 8
 #endif
 
+// Array length, from which counting sort scatters elements through per-bucket staging buffers (write-combining).
+#define THRESHOLD_WRITE_COMBINING_SCATTER (1 << 16)
+// Number of elements in staging buffer of one bucket. Should fill one cache line.
+#if DATA_TYPE_BITS == 32
+#define ELEMS_STAGING_BUFFER 16
+#else
+#define ELEMS_STAGING_BUFFER 8
+#endif
+// If 1, full cache lines are flushed from staging buffers with non-temporal (streaming) stores. If 0, regular
+// stores are used and destination of next flush is prefetched.
+#define USE_STREAMING_STORES_SCATTER 1
+// How many elements ahead are input keys and values prefetched in write-combining scatter.
+#define PREFETCH_DISTANCE_SCATTER 64
+
+
+/* --------- IN-PLACE ALGORITHM PARAMETERS ----------- */
+
+// How many bits is the one radix digit made of in in-place MSD radix sort. Bucket counters are allocated on
+// stack for every level of recursion, so it shouldn't be greater than 12.
+#if DATA_TYPE_BITS == 32
+#define BIT_COUNT_IN_PLACE_KO 8
+#define BIT_COUNT_IN_PLACE_KV 8
+#else
+#define BIT_COUNT_IN_PLACE_KO 8
+#define BIT_COUNT_IN_PLACE_KV 8
+#endif
+// Threshold, when small sort is applied to bucket (in our case insertion sort).
+#if DATA_TYPE_BITS == 32
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KO 32
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KV 32
+#else
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KO 32
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KV 32
+#endif
+
+
+/* --------- ADAPTIVE ALGORITHM PARAMETERS ----------- */
+
+// Range of bits in radix digit, for which adaptive sequential radix sort is compiled. Number of bits is selected
+// at runtime from this range. Max value is 16.
+#define BIT_COUNT_ADAPTIVE_MIN 4
+#define BIT_COUNT_ADAPTIVE_MAX 16
+// Estimated cost of scattering one element (in percent of cost, when buckets and counters fit into L1 cache), if
+// they only fit into L2 cache or if they don't fit into L2 cache.
+#define SCATTER_COST_L2_ADAPTIVE 125
+#define SCATTER_COST_MEMORY_ADAPTIVE 300
+// Cache sizes, which are used if they can't be detected on host.
+#define DEFAULT_CACHE_SIZE_L1_ADAPTIVE (32 * 1024)
+#define DEFAULT_CACHE_SIZE_L2_ADAPTIVE (256 * 1024)
+
+/* ---------- HYBRID ALGORITHM PARAMETERS ------------ */
+
+// How many bits is the one radix digit made of (for MSD partitioning and LSD passes inside buckets).
+#if DATA_TYPE_BITS == 32
+#define BIT_COUNT_HYBRID_KO 8
+#define BIT_COUNT_HYBRID_KV 8
+#else
+#define BIT_COUNT_HYBRID_KO 8
+#define BIT_COUNT_HYBRID_KV 8
+#endif
+// Buckets are sorted with LSD passes, if their keys, values and buffers occupy at most this percent of L2 cache.
+#define CACHE_PERCENT_BUCKET_HYBRID 50
+// L2 cache size, which is used if it can't be detected on host.
+#define DEFAULT_CACHE_SIZE_L2_HYBRID (256 * 1024)
+// How many host threads sort buckets. If 0, the number of concurrent threads supported by host is used.
+#define NUM_THREADS_HYBRID 1
+
+/* ------- MULTITHREADED ALGORITHM PARAMETERS -------- */
+
+// How many bits is the one radix digit made of (one digit is processed in one iteration).
+#if DATA_TYPE_BITS == 32
+#define BIT_COUNT_MULTITHREADED_KO 8
+#define BIT_COUNT_MULTITHREADED_KV 8
+#else
+#define BIT_COUNT_MULTITHREADED_KO 8
+#define BIT_COUNT_MULTITHREADED_KV 8
+#endif
+// How many host threads are used. If 0, the number of concurrent threads supported by host is used.
+#define NUM_THREADS_MULTITHREADED 0
+// Minimum number of elements processed by one thread. Limits the number of threads used for short arrays.
+#if DATA_TYPE_BITS == 32
+#define MIN_ELEMS_PER_THREAD_KO (1 << 14)
+#define MIN_ELEMS_PER_THREAD_KV (1 << 13)
+#else
+#define MIN_ELEMS_PER_THREAD_KO (1 << 13)
+#define MIN_ELEMS_PER_THREAD_KV (1 << 13)
+#endif
+
 #endif
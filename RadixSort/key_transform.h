@@ -0,0 +1,78 @@
+#ifndef KEY_TRANSFORM_RADIX_SORT_H
+#define KEY_TRANSFORM_RADIX_SORT_H
+
+#include <cuda.h>
+#include "cuda_runtime.h"
+#include "device_launch_parameters.h"
+
+#include "../Utils/data_types_common.h"
+#include "constants.h"
+
+
+/*
+Radix sort orders keys by their bits as unsigned integers in ascending order. Keys of other types and orders are
+transformed with order-preserving bit transforms before sort and restored after sort:
+- signed integers: sign bit is flipped
+- floating-point numbers: for negative numbers all bits are flipped, for positive numbers only sign bit
+- descending order: all bits are inverted (after the transform of key type)
+*/
+
+// Sign bit of "data_t"
+#define SIGN_BIT_RADIX ((data_t)1 << (DATA_TYPE_BITS - 1))
+
+// Values used for padding in parallel radix sort - after transform they are equal to MAX_VAL, so they end up at the
+// end of sorted array.
+#if RADIX_KEY_TYPE == KEY_TYPE_SIGNED
+#define PADDING_VAL_ASC_RADIX (MAX_VAL >> 1)
+#define PADDING_VAL_DESC_RADIX SIGN_BIT_RADIX
+#elif RADIX_KEY_TYPE == KEY_TYPE_FLOAT
+#define PADDING_VAL_ASC_RADIX (MAX_VAL >> 1)
+#define PADDING_VAL_DESC_RADIX MAX_VAL
+#else
+#define PADDING_VAL_ASC_RADIX MAX_VAL
+#define PADDING_VAL_DESC_RADIX MIN_VAL
+#endif
+
+
+/*
+Returns true, if key transform changes keys (keys aren't unsigned or sort order isn't ascending).
+*/
+template <order_t sortOrder>
+inline __host__ __device__ bool isKeyTransformed()
+{
+    return sortOrder == ORDER_DESC || RADIX_KEY_TYPE != KEY_TYPE_UNSIGNED;
+}
+
+/*
+Transforms key, so that its bits as unsigned integer are ordered in ascending order.
+*/
+template <order_t sortOrder>
+inline __host__ __device__ data_t transformKey(data_t key)
+{
+#if RADIX_KEY_TYPE == KEY_TYPE_SIGNED
+    key ^= SIGN_BIT_RADIX;
+#elif RADIX_KEY_TYPE == KEY_TYPE_FLOAT
+    key ^= ((data_t)0 - (key >> (DATA_TYPE_BITS - 1))) | SIGN_BIT_RADIX;
+#endif
+
+    return sortOrder == ORDER_ASC ? key : ~key;
+}
+
+/*
+Restores key transformed with "transformKey()".
+*/
+template <order_t sortOrder>
+inline __host__ __device__ data_t restoreKey(data_t key)
+{
+    key = sortOrder == ORDER_ASC ? key : ~key;
+
+#if RADIX_KEY_TYPE == KEY_TYPE_SIGNED
+    key ^= SIGN_BIT_RADIX;
+#elif RADIX_KEY_TYPE == KEY_TYPE_FLOAT
+    key ^= ((key >> (DATA_TYPE_BITS - 1)) - 1) | SIGN_BIT_RADIX;
+#endif
+
+    return key;
+}
+
+#endif
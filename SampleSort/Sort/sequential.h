@@ -7,6 +7,7 @@
 #include <random>
 #include <functional>
 #include <chrono>
+#include <type_traits>
 
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_correct.h"
@@ -15,6 +16,23 @@
 #include "../constants.h"
 
 
+/*
+Computes at compile time the number of levels of splitter tree, which is the smallest complete binary tree with at
+least "numSplitters" nodes (the number of bits needed to represent "numSplitters").
+*/
+template <uint_t numSplitters>
+struct SplitterTreeLevels
+{
+    enum { value = 1 + SplitterTreeLevels<numSplitters / 2>::value };
+};
+
+template <>
+struct SplitterTreeLevels<0>
+{
+    enum { value = 0 };
+};
+
+
 /*
 Parent class for sequential sample sort. Not to be used directly - it's inherited by bottom class, which performs
 partial template specialization.
@@ -33,14 +51,15 @@ class SampleSortSequentialParent : public MergeSortSequential
 {
 protected:
     std::string _sortName = "Sample sort sequential";
+    // Type of bucket indexes - 8 bits are enough for up to 256 buckets, otherwise 16 bits are used
+    typedef typename std::conditional<
+        numSplittersKo < 256 && numSplittersKv < 256, uint8_t, uint16_t
+    >::type bucket_t;
 
-    // Arrays where sorted sequence is saved. It's needed because subsequences are moved from primary and buffer
-    // memory. This way some of the sorted array would end up in primary array and other part in buffer.
-    data_t *_h_keysSorted = NULL, *_h_valuesSorted = NULL;
     // Holds samples and after samples are sorted holds splitters in sequential sample sort
     data_t *_h_samples;
     // For every element in input holds bucket index to which it belongs (needed for sequential sample sort)
-    uint_t *_h_elementBuckets;
+    bucket_t *_h_elementBuckets;
 
     /*
     Method for allocating memory needed both for key only and key-value sort.
@@ -51,40 +70,14 @@ protected:
 
         uint_t maxNumSamples = max(numSamplesKo, numSamplesKv);
 
-        _h_keysSorted = (data_t*)malloc(arrayLength * sizeof(*_h_keysSorted));
-        checkMallocError(_h_keysSorted);
-        _h_valuesSorted = (data_t*)malloc(arrayLength * sizeof(*_h_valuesSorted));
-        checkMallocError(_h_valuesSorted);
-
         // Holds samples and splitters in sequential sample sort (needed for sequential sample sort)
         _h_samples = (data_t*)malloc(maxNumSamples * sizeof(*_h_samples));
         checkMallocError(_h_samples);
         // For each element in array holds, to which bucket it belongs (needed for sequential sample sort)
-        _h_elementBuckets = (uint_t*)malloc(arrayLength * sizeof(*_h_elementBuckets));
+        _h_elementBuckets = (bucket_t*)malloc(arrayLength * sizeof(*_h_elementBuckets));
         checkMallocError(_h_elementBuckets);
     }
 
-    /*
-    Sorted sequence is located in sorted array.
-    */
-    virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
-    {
-        std::copy(_h_keysSorted, _h_keysSorted + arrayLength, h_keys);
-        if (h_values != NULL)
-        {
-            std::copy(_h_valuesSorted, _h_valuesSorted + arrayLength, h_values);
-        }
-    }
-
-    /*
-    Returns the output array. Implemented because sample sort class (which is derived from this class) requires
-    different function to determine output array than this class.
-    */
-    virtual data_t* getOutputMergeArray(data_t *arrayBuffer, data_t *arraySorted, bool isLastMergePhase)
-    {
-        return isLastMergePhase ? arraySorted : arrayBuffer;
-    }
-
     /*
     From provided array collects "numSamples" samples and sorts them.
     */
@@ -106,29 +99,91 @@ protected:
     }
 
     /*
-    Performs inclusive binary search and returns index where element should be located.
+    Builds implicit splitter tree from sorted splitters. Tree is stored in level-order (Eytzinger layout) - root
+    is located at index 1 and children of node "j" are located at indexes "2 * j" and "2 * j + 1". If tree has
+    more nodes than there are splitters, missing splitters are padded with MAX/MIN value (depending on sort order),
+    so padded nodes never direct elements to the right subtree.
     */
-    template <order_t sortOrder>
-    int binarySearchInclusive(data_t* h_keys, data_t target, uint_t arrayLength)
+    template <order_t sortOrder, uint_t numSplitters>
+    void buildSplitterTree(data_t *splitters, data_t *splitterTree)
     {
-        int_t indexStart = 0;
-        int_t indexEnd = arrayLength - 1;
+        const uint_t numLevels = SplitterTreeLevels<numSplitters>::value;
+        data_t minMaxValue = sortOrder == ORDER_ASC ? MAX_VAL : MIN_VAL;
 
-        while (indexStart <= indexEnd)
+        for (uint_t level = 0; level < numLevels; level++)
         {
-            int index = (indexStart + indexEnd) / 2;
+            for (uint_t i = 0; i < ((uint_t)1 << level); i++)
+            {
+                // Index of splitter in sorted array, which is the "i-th" node on current level in in-order
+                uint_t splitterIndex = ((2 * i + 1) << (numLevels - level - 1)) - 1;
+                uint_t node = ((uint_t)1 << level) + i;
+
+                splitterTree[node] = splitterIndex < numSplitters ? splitters[splitterIndex] : minMaxValue;
+            }
+        }
+    }
+
+    /*
+    For every element finds the bucket, to which it belongs, and counts the elements in buckets. Bucket index
+    equals the number of splitters lower than element (same as inclusive binary search over splitters).
 
-            if (sortOrder == ORDER_ASC ? (target <= h_keys[index]) : (target >= h_keys[index]))
+    Splitter tree is traversed without branches - on every level the result of comparison is added to the index
+    of the next node. The number of levels is known at compile time, so the loops get unrolled. Multiple elements
+    are classified at once, which interleaves their independent loads from splitter tree.
+    */
+    template <order_t sortOrder, uint_t numSplitters>
+    void classifyElements(
+        data_t *h_keys, data_t *splitterTree, bucket_t *h_elementBuckets, uint_t *bucketSizes, uint_t arrayLength
+    )
+    {
+        const uint_t numLevels = SplitterTreeLevels<numSplitters>::value;
+        const uint_t numElements = NUM_ELEMS_CLASSIFY_SEQUENTIAL;
+        uint_t i = 0;
+
+        for (; i + numElements <= arrayLength; i += numElements)
+        {
+            data_t keys[numElements];
+            uint_t nodes[numElements];
+
+            for (uint_t e = 0; e < numElements; e++)
+            {
+                keys[e] = h_keys[i + e];
+                nodes[e] = 1;
+            }
+
+            for (uint_t level = 0; level < numLevels; level++)
             {
-                indexEnd = index - 1;
+                for (uint_t e = 0; e < numElements; e++)
+                {
+                    data_t splitter = splitterTree[nodes[e]];
+                    nodes[e] = 2 * nodes[e] + (sortOrder == ORDER_ASC ? splitter < keys[e] : splitter > keys[e]);
+                }
             }
-            else
+
+            for (uint_t e = 0; e < numElements; e++)
             {
-                indexStart = index + 1;
+                bucket_t bucket = nodes[e] - ((uint_t)1 << numLevels);
+                bucketSizes[bucket]++;
+                h_elementBuckets[i + e] = bucket;
             }
         }
 
-        return indexStart;
+        // Remaining elements are classified one by one
+        for (; i < arrayLength; i++)
+        {
+            data_t key = h_keys[i];
+            uint_t node = 1;
+
+            for (uint_t level = 0; level < numLevels; level++)
+            {
+                data_t splitter = splitterTree[node];
+                node = 2 * node + (sortOrder == ORDER_ASC ? splitter < key : splitter > key);
+            }
+
+            bucket_t bucket = node - ((uint_t)1 << numLevels);
+            bucketSizes[bucket]++;
+            h_elementBuckets[i] = bucket;
+        }
     }
 
     /*
@@ -148,15 +203,17 @@ protected:
     }
 
     /*
-    Sorts array with sample sort and outputs sorted data to result array.
+    Sorts array with sample sort. Buckets are moved between primary and buffer array on every level of recursion,
+    so every recursive call is told, to which of its arrays sorted bucket has to be output. This way all buckets
+    end up in primary array of the top level and sorted array doesn't have to be copied after sort.
     */
     template <
         order_t sortOrder, uint_t sortingKeyOnly, uint_t numSplitters, uint_t oversamplingFactor,
         uint_t smallSortThreashold
     >
     void sampleSortSequential(
-        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
-        data_t *h_valuesSorted, data_t *h_samples, uint_t *h_elementBuckets, uint_t arrayLength
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_samples,
+        bucket_t *h_elementBuckets, uint_t arrayLength, bool isOutputToBuffer
     )
     {
         // When array is small enough, it is sorted with small sort (in our case merge sort).
@@ -164,7 +221,7 @@ protected:
         if (arrayLength <= smallSortThreashold)
         {
             mergeSortSequential<sortOrder, sortingKeyOnly>(
-                h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, arrayLength
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, arrayLength, isOutputToBuffer
             );
             return;
         }
@@ -186,13 +243,12 @@ protected:
         // For "numSplitters" splitters "numSplitters + 1" buckets are created
         bucketSizes[numSplitters] = 0;
 
+        // Splitter tree with "2^levels - 1" nodes (index 0 isn't used)
+        data_t splitterTree[1 << SplitterTreeLevels<numSplitters>::value];
+        buildSplitterTree<sortOrder, numSplitters>(splitters, splitterTree);
+
         // For all elements in data table searches, which bucket they belong to and counts the elements in buckets
-        for (uint_t i = 0; i < arrayLength; i++)
-        {
-            uint_t bucket = binarySearchInclusive<sortOrder>(splitters, h_keys[i], numSplitters);
-            bucketSizes[bucket]++;
-            h_elementBuckets[i] = bucket;
-        }
+        classifyElements<sortOrder, numSplitters>(h_keys, splitterTree, h_elementBuckets, bucketSizes, arrayLength);
 
         // Performs an EXCLUSIVE scan over array of bucket sizes in order to get bucket offsets
         exclusiveScan(bucketSizes, numSplitters + 1);
@@ -223,20 +279,20 @@ protected:
             if (bucketSize == arrayLength)
             {
                 mergeSortSequential<sortOrder, sortingKeyOnly>(
-                    h_keysBuffer, h_valuesBuffer, h_keys, h_values, h_keysSorted, h_valuesSorted, arrayLength
+                    h_keysBuffer, h_valuesBuffer, h_keys, h_values, arrayLength, !isOutputToBuffer
                 );
                 return;
             }
 
             if (bucketSize > 0)
             {
-                // Primary and buffer arrays are exchanged
+                // Primary and buffer arrays are exchanged, so the output array is exchanged too
                 if (sortingKeyOnly)
                 {
                     sampleSortSequential
                         <sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor, smallSortThreashold>(
-                        h_keysBuffer + prevBucketOffset, NULL, h_keys + prevBucketOffset, NULL,
-                        h_keysSorted + prevBucketOffset, NULL, h_samples, h_elementBuckets, bucketSize
+                        h_keysBuffer + prevBucketOffset, NULL, h_keys + prevBucketOffset, NULL, h_samples,
+                        h_elementBuckets, bucketSize, !isOutputToBuffer
                     );
                 }
                 else
@@ -244,8 +300,7 @@ protected:
                     sampleSortSequential
                         <sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor, smallSortThreashold>(
                         h_keysBuffer + prevBucketOffset, h_valuesBuffer + prevBucketOffset, h_keys + prevBucketOffset,
-                        h_values + prevBucketOffset, h_keysSorted + prevBucketOffset,
-                        h_valuesSorted + prevBucketOffset, h_samples, h_elementBuckets, bucketSize
+                        h_values + prevBucketOffset, h_samples, h_elementBuckets, bucketSize, !isOutputToBuffer
                     );
                 }
             }
@@ -258,18 +313,18 @@ protected:
     */
     void sortKeyOnly()
     {
+        _bytesCopySaved = (uint64_t)_arrayLength * sizeof(*_h_keys);
+
         if (_sortOrder == ORDER_ASC)
         {
             sampleSortSequential<ORDER_ASC, true, numSplittersKo, oversamplingFactorKo, smallSortThresholdKo>(
-                _h_keys, NULL, _h_keysBuffer, NULL, _h_keysSorted, NULL, _h_samples, _h_elementBuckets,
-                _arrayLength
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_samples, _h_elementBuckets, _arrayLength, false
             );
         }
         else
         {
             sampleSortSequential<ORDER_DESC, true, numSplittersKo, oversamplingFactorKo, smallSortThresholdKo>(
-                _h_keys, NULL, _h_keysBuffer, NULL, _h_keysSorted, NULL, _h_samples, _h_elementBuckets,
-                _arrayLength
+                _h_keys, NULL, _h_keysBuffer, NULL, _h_samples, _h_elementBuckets, _arrayLength, false
             );
         }
     }
@@ -280,18 +335,20 @@ protected:
     */
     void sortKeyValue()
     {
+        _bytesCopySaved = 2 * (uint64_t)_arrayLength * sizeof(*_h_keys);
+
         if (_sortOrder == ORDER_ASC)
         {
             sampleSortSequential<ORDER_ASC, false, numSplittersKv, oversamplingFactorKv, smallSortThresholdKv>(
-                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_keysSorted, _h_valuesSorted, _h_samples,
-                _h_elementBuckets, _arrayLength
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_samples, _h_elementBuckets, _arrayLength,
+                false
             );
         }
         else
         {
             sampleSortSequential<ORDER_DESC, false, numSplittersKv, oversamplingFactorKv, smallSortThresholdKv>(
-                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_keysSorted, _h_valuesSorted, _h_samples,
-                _h_elementBuckets, _arrayLength
+                _h_keys, _h_values, _h_keysBuffer, _h_valuesBuffer, _h_samples, _h_elementBuckets, _arrayLength,
+                false
             );
         }
     }
@@ -314,8 +371,6 @@ public:
 
         MergeSortSequential::memoryDestroy();
 
-        free(_h_keysSorted);
-        free(_h_valuesSorted);
         free(_h_samples);
         free(_h_elementBuckets);
     }
@@ -129,6 +129,9 @@ _KV: Key-value
 #define NUM_SPLITTERS_SEQUENTIAL_KV 16
 #endif
 
+// How many elements are classified into buckets at once (their traversals of splitter tree are interleaved).
+#define NUM_ELEMS_CLASSIFY_SEQUENTIAL 8
+
 // How many extra samples are taken for every splitter. Increases the quality of splitters (samples
 // get sorted and only "NUM_SPLITTERS_SEQUENTIAL" splitters are taken from sorted array of samples).
 #if DATA_TYPE_BITS == 32
@@ -2,6 +2,14 @@
 #include <stdint.h>
 #include <string.h>
 #include <random>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 #include <cuda.h>
 #include "cuda_runtime.h"
@@ -220,3 +228,107 @@ std::string strSlugify(std::string text)
 {
     return strReplace(text, ' ', '_');
 }
+
+/*
+Returns the size of host data cache on provided level (1, 2 or 3) in bytes. If it can't be determined, returns 0.
+*/
+uint_t getHostCacheSize(uint_t level)
+{
+#ifdef _WIN32
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformation(NULL, &bufferSize);
+
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION *buffer = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION*)malloc(bufferSize);
+    if (buffer == NULL || !GetLogicalProcessorInformation(buffer, &bufferSize))
+    {
+        free(buffer);
+        return 0;
+    }
+
+    uint_t cacheSize = 0;
+    for (uint_t i = 0; i < bufferSize / sizeof(*buffer); i++)
+    {
+        CACHE_DESCRIPTOR *cache = &buffer[i].Cache;
+
+        if (buffer[i].Relationship == RelationCache && cache->Level == level && cache->Type != CacheInstruction)
+        {
+            cacheSize = cache->Size;
+            break;
+        }
+    }
+
+    free(buffer);
+    return cacheSize;
+#else
+    long cacheSize = 0;
+
+    if (level == 1)
+    {
+        cacheSize = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    }
+    else if (level == 2)
+    {
+        cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+    else if (level == 3)
+    {
+        cacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    }
+
+    return cacheSize > 0 ? (uint_t)cacheSize : 0;
+#endif
+}
+
+/*
+Returns true, if host CPU and operating system support AVX2 instructions.
+*/
+bool isHostAvx2Supported()
+{
+#ifdef _MSC_VER
+    int cpuInfo[4];
+
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7)
+    {
+        return false;
+    }
+
+    // OS has to save AVX registers (OSXSAVE and AVX flags, XMM and YMM state enabled)
+    __cpuidex(cpuInfo, 1, 0);
+    if ((cpuInfo[2] & (1 << 27)) == 0 || (cpuInfo[2] & (1 << 28)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/*
+Returns true, if host CPU and operating system support AVX-512 Foundation instructions.
+*/
+bool isHostAvx512Supported()
+{
+#ifdef _MSC_VER
+    int cpuInfo[4];
+
+    if (!isHostAvx2Supported())
+    {
+        return false;
+    }
+
+    // OS has to save AVX-512 registers (opmask, ZMM_Hi256 and Hi16_ZMM state enabled)
+    if ((_xgetbv(0) & 0xE6) != 0xE6)
+    {
+        return false;
+    }
+
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & (1 << 16)) != 0;
+#else
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
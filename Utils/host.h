@@ -18,5 +18,8 @@ char* getDistributionName(data_dist_t distribution);
 std::string strCapitalize(std::string str);
 std::string strReplace(std::string text, char from, char to);
 std::string strSlugify(std::string text);
+uint_t getHostCacheSize(uint_t level);
+bool isHostAvx2Supported();
+bool isHostAvx512Supported();
 
 #endif
@@ -23,10 +23,12 @@ class AddPaddingBase
 {
 private:
     /*
-    Adds padding of MAX/MIN values to input table, depending if sort order is ascending or descending.
+    Adds padding of provided value to input table.
     */
-    template <order_t sortOrder, bool fillBuffer>
-    void runAddPaddingKernel(data_t *d_arrayPrimary, data_t *d_arrayBuffer, uint_t indexStart, uint_t indexEnd)
+    template <data_t value, bool fillBuffer>
+    void runAddPaddingValueKernel(
+        data_t *d_arrayPrimary, data_t *d_arrayBuffer, uint_t indexStart, uint_t indexEnd
+    )
     {
         if (indexStart == indexEnd)
         {
@@ -38,22 +40,39 @@ private:
         dim3 dimGrid((paddingLength - 1) / elemsPerThreadBlock + 1, 1, 1);
         dim3 dimBlock(threadsPadding, 1, 1);
 
+        addPaddingKernel<threadsPadding, elemsPadding, fillBuffer, value><<<dimGrid, dimBlock>>>(
+            d_arrayPrimary, d_arrayBuffer, indexStart, paddingLength
+        );
+    }
+
+    /*
+    Adds padding of MAX/MIN values to input table, depending if sort order is ascending or descending.
+    */
+    template <order_t sortOrder, bool fillBuffer>
+    void runAddPaddingKernel(data_t *d_arrayPrimary, data_t *d_arrayBuffer, uint_t indexStart, uint_t indexEnd)
+    {
         // Depending on sort order different value is used for padding.
         if (sortOrder == ORDER_ASC)
         {
-            addPaddingKernel<threadsPadding, elemsPadding, fillBuffer, MAX_VAL><<<dimGrid, dimBlock>>>(
-                d_arrayPrimary, d_arrayBuffer, indexStart, paddingLength
-            );
+            runAddPaddingValueKernel<MAX_VAL, fillBuffer>(d_arrayPrimary, d_arrayBuffer, indexStart, indexEnd);
         }
         else
         {
-            addPaddingKernel<threadsPadding, elemsPadding, fillBuffer, MIN_VAL><<<dimGrid, dimBlock>>>(
-                d_arrayPrimary, d_arrayBuffer, indexStart, paddingLength
-            );
+            runAddPaddingValueKernel<MIN_VAL, fillBuffer>(d_arrayPrimary, d_arrayBuffer, indexStart, indexEnd);
         }
     }
 
 protected:
+    /*
+    Adds padding of provided value for primary array only. Needed if padding value doesn't depend only on sort
+    order (for example when keys are transformed before sort).
+    */
+    template <data_t value>
+    void runAddPaddingValueKernel(data_t *d_arrayPrimary, uint_t indexStart, uint_t indexEnd)
+    {
+        runAddPaddingValueKernel<value, false>(d_arrayPrimary, NULL, indexStart, indexEnd);
+    }
+
     /*
     Adds padding for primary array only.
     */
@@ -0,0 +1,17 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <immintrin.h>
+
+
+// Functions with SIMD instructions, which aren't enabled for whole program, have to be compiled for target
+// instruction set. They can only be called if host supports it (see "isHostAvx2Supported()").
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#define TARGET_AVX512
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+#endif
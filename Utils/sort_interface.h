@@ -36,6 +36,9 @@ protected:
     double _sortTime = -1;
     // Denotes if sort timing should be executed
     bool _stopwatchEnabled = false;
+    // Number of bytes, which didn't have to be copied from buffer after last sort, because sort was planned to
+    // output sorted array to primary array
+    uint64_t _bytesCopySaved = 0;
 
     /*
     Executes the sort.
@@ -136,6 +139,14 @@ public:
         return _sortTime;
     }
 
+    /*
+    Returns the number of bytes, which didn't have to be copied from buffer after last sort.
+    */
+    uint64_t getBytesCopySaved()
+    {
+        return _bytesCopySaved;
+    }
+
     /*
     Method for destroying memory needed for sort. For sort testing purposes this method is public.
     */
@@ -0,0 +1,30 @@
+#include <thread>
+
+#include "data_types_common.h"
+
+
+/*
+Returns the number of concurrent threads supported by host. If it can't be determined, returns 1.
+*/
+uint_t getNumHostThreads()
+{
+    uint_t numThreads = std::thread::hardware_concurrency();
+    return numThreads > 0 ? numThreads : 1;
+}
+
+/*
+Array is divided into "numThreads" contiguous chunks of (almost) equal length. Returns start index of the chunk,
+which belongs to provided thread.
+*/
+uint_t getThreadChunkStart(uint_t threadIndex, uint_t numThreads, uint_t arrayLength)
+{
+    return (uint_t)(((uint64_t)arrayLength * threadIndex) / numThreads);
+}
+
+/*
+Returns end index (exclusive) of the chunk, which belongs to provided thread.
+*/
+uint_t getThreadChunkEnd(uint_t threadIndex, uint_t numThreads, uint_t arrayLength)
+{
+    return getThreadChunkStart(threadIndex + 1, numThreads, arrayLength);
+}
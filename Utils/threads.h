@@ -0,0 +1,79 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "data_types_common.h"
+
+
+uint_t getNumHostThreads();
+uint_t getThreadChunkStart(uint_t threadIndex, uint_t numThreads, uint_t arrayLength);
+uint_t getThreadChunkEnd(uint_t threadIndex, uint_t numThreads, uint_t arrayLength);
+
+/*
+Executes "function(threadIndex)" on "numThreads" host threads and waits for all of them to finish. Thread with
+index 0 runs on the calling thread.
+*/
+template <typename Function>
+void runHostThreads(uint_t numThreads, Function function)
+{
+    std::vector<std::thread> threads;
+
+    for (uint_t threadIndex = 1; threadIndex < numThreads; threadIndex++)
+    {
+        threads.push_back(std::thread(function, threadIndex));
+    }
+
+    function(0);
+
+    for (uint_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+}
+
+/*
+Barrier for host threads, which waits in spin loop instead of sleeping in kernel, because threads are released
+after short steps. After a number of spins thread yields, so that waiting doesn't block other threads, if there
+are more threads than cores.
+*/
+class SpinBarrier
+{
+private:
+    static const uint_t _spinsBeforeYield = 1024;
+    uint_t _numThreads;
+    std::atomic<uint_t> _numWaiting;
+    // Incremented every time all threads reach the barrier
+    std::atomic<uint_t> _generation;
+
+public:
+    SpinBarrier(uint_t numThreads) : _numThreads(numThreads), _numWaiting(0), _generation(0) {}
+
+    /*
+    Waits until all threads reach the barrier.
+    */
+    void wait()
+    {
+        uint_t generation = _generation.load(std::memory_order_acquire);
+
+        // The last thread resets counter and releases other threads
+        if (_numWaiting.fetch_add(1, std::memory_order_acq_rel) == _numThreads - 1)
+        {
+            _numWaiting.store(0, std::memory_order_relaxed);
+            _generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+
+        for (uint_t spin = 0; _generation.load(std::memory_order_acquire) == generation; spin++)
+        {
+            if (spin >= _spinsBeforeYield)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+#endif